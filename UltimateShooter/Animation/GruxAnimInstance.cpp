@@ -3,20 +3,43 @@
 
 #include "GruxAnimInstance.h"
 #include "UltimateShooter/Characters/Enemy.h"
+#include "UltimateShooter/UltimateShooter.h"
+
+DECLARE_CYCLE_STAT(TEXT("Grux Anim Gather"), STAT_GruxAnimGather, STATGROUP_UltimateShooter);
 
 void UGruxAnimInstance::UpdateAnimationProperties(float DeltaTime)
 {
+    //! NativeUpdateAnimation and NativeThreadSafeUpdateAnimation do the update now
+}
+
+void UGruxAnimInstance::NativeInitializeAnimation()
+{
+    Super::NativeInitializeAnimation();
+
+    Enemy = Cast<AEnemy>(TryGetPawnOwner());
+    EnemyVelocity = FVector::ZeroVector;
+    Speed = 0.f;
+}
+
+void UGruxAnimInstance::NativeUpdateAnimation(float DeltaSeconds)
+{
+    SCOPE_CYCLE_COUNTER(STAT_GruxAnimGather);
+
+    Super::NativeUpdateAnimation(DeltaSeconds);
+
     if (Enemy == nullptr)
     {
         Enemy = Cast<AEnemy>(TryGetPawnOwner());
     }
 
-    if (Enemy)
-    {
-        FVector Velocity{ Enemy->GetVelocity() };
-        Velocity.Z = 0.f;
-        Speed = Velocity.Size();
+    EnemyVelocity = Enemy ? Enemy->GetVelocity() : FVector::ZeroVector;
+}
 
-        // bDead = Enemy->GetDying();
-    }
-}
\ No newline at end of file
+void UGruxAnimInstance::NativeThreadSafeUpdateAnimation(float DeltaSeconds)
+{
+    Super::NativeThreadSafeUpdateAnimation(DeltaSeconds);
+
+    FVector Velocity{ EnemyVelocity };
+    Velocity.Z = 0.f;
+    Speed = Velocity.Size();
+}
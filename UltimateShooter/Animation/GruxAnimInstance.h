@@ -16,9 +16,18 @@ class ULTIMATESHOOTER_API UGruxAnimInstance : public UAnimInstance
 	GENERATED_BODY()
 
 public:
-	UFUNCTION(BlueprintCallable)
+	//! Kept for existing Anim Blueprints, properties are now updated in NativeThreadSafeUpdateAnimation
+	UFUNCTION(BlueprintCallable, meta = (DeprecatedFunction, DeprecationMessage = "Properties are updated natively, remove the call from the event graph"))
 	void UpdateAnimationProperties(float DeltaTime);
 
+	virtual void NativeInitializeAnimation() override;
+
+	//! Copies the enemy velocity on the game thread
+	virtual void NativeUpdateAnimation(float DeltaSeconds) override;
+
+	//! Computes Speed from the copied velocity, can run on a worker thread
+	virtual void NativeThreadSafeUpdateAnimation(float DeltaSeconds) override;
+
 private:
 	//! Lateral Movement speed
 	UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Category = Movement, meta = (AllowPrivateAccess = "true"))
@@ -26,6 +35,9 @@ private:
 	
 	UPROPERTY(VisibleAnywhere, BlueprintReadOnly, meta = (AllowPrivateAccess = "true"))
 	class AEnemy* Enemy;
+
+	//! Enemy velocity of this frame, written on the game thread only
+	FVector EnemyVelocity;
 	
 	// UPROPERTY(VisibleAnywhere, BlueprintReadOnly, meta = (AllowPrivateAccess = "true"))
 	// bool bDead;
@@ -9,11 +9,16 @@
 #include "Kismet/KismetMathLibrary.h"
 #include "Kismet/GameplayStatics.h"
 #include "TimerManager.h"
+#include "UltimateShooter/UltimateShooter.h"
+
+DECLARE_CYCLE_STAT(TEXT("Shooter Anim Gather"), STAT_ShooterAnimGather, STATGROUP_UltimateShooter);
+DECLARE_CYCLE_STAT(TEXT("Shooter Anim Thread Safe Update"), STAT_ShooterAnimThreadSafeUpdate, STATGROUP_UltimateShooter);
 
 UShooterAnimInstance::UShooterAnimInstance() :
     Speed{0.f}, bIsInAir{false}, bIsAccelerating{false}, MovementOffsetYaw{0.f}, LastMovementOffsetYaw{0.f},
     bAiming{false}, TIPCharacterYaw{0.f}, TIPCharacterYawLastFrame{0.f}, RootYawOffset{0.f}, RotationCurve{-90.f}, 
-    RotationCurveLastFrame{0.f}, Pitch{0.f}, bReloading{0.f}, OffsetState{EOffsetState::EOS_Hip}, CharacterRotation{FRotator(0.f)},
+    RotationCurveLastFrame{0.f}, TurningCurveName{TEXT("Turning")}, RotationCurveName{TEXT("Rotation")}, Pitch{0.f},
+    bReloading{0.f}, OffsetState{EOffsetState::EOS_Hip}, CharacterRotation{FRotator(0.f)},
     CharacterRotationLastFrame{FRotator(0.f)}, YawDelta{0.f}, RecoilWeight{1.0f}, bTurningInPlace{false}, 
     EquippedWeaponType{EWeaponType::EWT_DefaultMAX}, bShouldUseFABRIK{false}
 {
@@ -23,82 +28,113 @@ UShooterAnimInstance::UShooterAnimInstance() :
 //! Works like tick
 void UShooterAnimInstance::UpdateAnimationProperties(float DeltaTime)
 {
+    //! NativeUpdateAnimation and NativeThreadSafeUpdateAnimation do the update now
+}
+
+void UShooterAnimInstance::NativeUpdateAnimation(float DeltaSeconds)
+{
+    SCOPE_CYCLE_COUNTER(STAT_ShooterAnimGather);
+
+    Super::NativeUpdateAnimation(DeltaSeconds);
+
     if(ShooterCharacter == nullptr)
     {
         ShooterCharacter = Cast<AShooterCharacter>(TryGetPawnOwner());
     }
 
-    if (ShooterCharacter)
+    Snapshot.bValid = ShooterCharacter != nullptr;
+    if (!Snapshot.bValid) return;
+
+    const ECombatState CombatState = ShooterCharacter->GetCombatState();
+    Snapshot.bReloading = CombatState == ECombatState::ECS_Reloading;
+    Snapshot.bEquipping = CombatState == ECombatState::ECS_Equipping;
+    Snapshot.bCrouching = ShooterCharacter->GetCrouching();
+    Snapshot.bAiming = ShooterCharacter->GetAiming();
+    Snapshot.bShouldUseFABRIK = !ShooterCharacter->GetGameStartAnimation() &&
+        (CombatState == ECombatState::ECS_Unoccupied || CombatState == ECombatState::ECS_FireTimerInProgress);
+
+    const UCharacterMovementComponent* Movement = ShooterCharacter->GetCharacterMovement();
+    Snapshot.bIsFalling = Movement->IsFalling();
+    Snapshot.bIsAccelerating = Movement->GetCurrentAcceleration().Size() > 0.f;
+
+    Snapshot.Velocity = ShooterCharacter->GetVelocity();
+    Snapshot.AimRotation = ShooterCharacter->GetBaseAimRotation();
+    Snapshot.ActorRotation = ShooterCharacter->GetActorRotation();
+
+    Snapshot.bHasWeapon = ShooterCharacter->GetEquippedWeapon() != nullptr;
+    if (Snapshot.bHasWeapon)
     {
-        bReloading = ShooterCharacter->GetCombatState() == ECombatState::ECS_Reloading;
-        bEquipping = ShooterCharacter->GetCombatState() == ECombatState::ECS_Equipping;
-        bCrouching = ShooterCharacter->GetCrouching();
-        if (ShooterCharacter->GetGameStartAnimation())
-        {
-            bShouldUseFABRIK = false;
-        }
-        else
-        {
-            bShouldUseFABRIK = ShooterCharacter->GetCombatState() == ECombatState::ECS_Unoccupied || ShooterCharacter->GetCombatState() == ECombatState::ECS_FireTimerInProgress;
-        }
-        
-        //! Get the lateral speed of the character
-        FVector Velocity{ ShooterCharacter->GetVelocity() };
-        Velocity.Z = 0.f;
-        Speed = Velocity.Size();
+        Snapshot.EquippedWeaponType = ShooterCharacter->GetEquippedWeapon()->GetWeaponType();
+    }
 
-        //! Is the character in the air
-        bIsInAir = ShooterCharacter->GetCharacterMovement()->IsFalling();
+    //! Curves are read here, the thread safe update only works on the copies
+    //! Rotation is only used while turning, so its lookup is skipped otherwise
+    Snapshot.TurningCurve = GetCurveValue(TurningCurveName);
+    Snapshot.RotationCurve = Snapshot.TurningCurve > 0.f ? GetCurveValue(RotationCurveName) : 0.f;
+}
 
-        //! Is the character Accelerating
-        if(ShooterCharacter->GetCharacterMovement()->GetCurrentAcceleration().Size() > 0.f)
-        {
-            bIsAccelerating = true;
-        }
-        else
-        {
-            bIsAccelerating = false;
-        }
+void UShooterAnimInstance::NativeThreadSafeUpdateAnimation(float DeltaSeconds)
+{
+    SCOPE_CYCLE_COUNTER(STAT_ShooterAnimThreadSafeUpdate);
 
-        //! Character Aiming Direction
-        FRotator AimRotation = ShooterCharacter->GetBaseAimRotation(); 
-        //! Character Movement Direction
-        FRotator MovementRotation = UKismetMathLibrary::MakeRotFromX(ShooterCharacter->GetVelocity());
-        //! Subtract Movement Rotation from Aiming Rotation to get Movement Yaw Offset for Animation Blend Space
-        MovementOffsetYaw = UKismetMathLibrary::NormalizedDeltaRotator(MovementRotation,AimRotation).Yaw;
+    Super::NativeThreadSafeUpdateAnimation(DeltaSeconds);
 
-        if(Velocity.Size() > 0.f)
-        {
-            LastMovementOffsetYaw = MovementOffsetYaw;
-        }
+    if (!Snapshot.bValid) return;
 
-        bAiming = ShooterCharacter->GetAiming();
+    bReloading = Snapshot.bReloading;
+    bEquipping = Snapshot.bEquipping;
+    bCrouching = Snapshot.bCrouching;
+    bShouldUseFABRIK = Snapshot.bShouldUseFABRIK;
 
-        if (bReloading)
-        {
-            OffsetState = EOffsetState::EOS_Reloading;
-        }
-        else if (bIsInAir)
-        {
-            OffsetState = EOffsetState::EOS_InAir;
-        }
-        else if (bAiming)
-        {
-            OffsetState = EOffsetState::EOS_Aiming;
-        }
-        else 
-        {
-            OffsetState = EOffsetState::EOS_Hip;
-        }
+    //! Get the lateral speed of the character
+    FVector Velocity{ Snapshot.Velocity };
+    Velocity.Z = 0.f;
+    Speed = Velocity.Size();
 
-        if (ShooterCharacter->GetEquippedWeapon())
-        {
-            EquippedWeaponType = ShooterCharacter->GetEquippedWeapon()->GetWeaponType();
-        }
+    //! Is the character in the air
+    bIsInAir = Snapshot.bIsFalling;
+
+    //! Is the character Accelerating
+    bIsAccelerating = Snapshot.bIsAccelerating;
+
+    //! Character Aiming Direction
+    const FRotator AimRotation = Snapshot.AimRotation;
+    //! Character Movement Direction
+    const FRotator MovementRotation = UKismetMathLibrary::MakeRotFromX(Snapshot.Velocity);
+    //! Subtract Movement Rotation from Aiming Rotation to get Movement Yaw Offset for Animation Blend Space
+    MovementOffsetYaw = UKismetMathLibrary::NormalizedDeltaRotator(MovementRotation,AimRotation).Yaw;
+
+    if(Velocity.Size() > 0.f)
+    {
+        LastMovementOffsetYaw = MovementOffsetYaw;
+    }
+
+    bAiming = Snapshot.bAiming;
+
+    if (bReloading)
+    {
+        OffsetState = EOffsetState::EOS_Reloading;
+    }
+    else if (bIsInAir)
+    {
+        OffsetState = EOffsetState::EOS_InAir;
+    }
+    else if (bAiming)
+    {
+        OffsetState = EOffsetState::EOS_Aiming;
+    }
+    else 
+    {
+        OffsetState = EOffsetState::EOS_Hip;
+    }
+
+    if (Snapshot.bHasWeapon)
+    {
+        EquippedWeaponType = Snapshot.EquippedWeaponType;
     }
 
     TurnInPlace();
-    Lean(DeltaTime);
+    Lean(DeltaSeconds);
 }
 
 //! Works like Constructor
@@ -110,15 +146,15 @@ void UShooterAnimInstance::NativeInitializeAnimation()
 
 void UShooterAnimInstance::TurnInPlace()
 {
-    if (ShooterCharacter == nullptr) return;
+    if (!Snapshot.bValid) return;
 
-    Pitch = ShooterCharacter->GetBaseAimRotation().Pitch;
+    Pitch = Snapshot.AimRotation.Pitch;
 
     if (Speed > 0 || bIsInAir)
     {
         //! Don't want to turn in place character is moving
         RootYawOffset = 0.f;
-        TIPCharacterYaw = ShooterCharacter->GetActorRotation().Yaw;
+        TIPCharacterYaw = Snapshot.ActorRotation.Yaw;
         TIPCharacterYawLastFrame = TIPCharacterYaw;
         RotationCurve = 0.f;
         RotationCurveLastFrame = 0.f;
@@ -126,19 +162,19 @@ void UShooterAnimInstance::TurnInPlace()
     else
     {
         TIPCharacterYawLastFrame = TIPCharacterYaw;
-        TIPCharacterYaw = ShooterCharacter->GetActorRotation().Yaw;
+        TIPCharacterYaw = Snapshot.ActorRotation.Yaw;
 
         const float TIPYawDelta = TIPCharacterYaw - TIPCharacterYawLastFrame;
 
         //! RootYaw Offset, updated and clamped to [-180,180]
         RootYawOffset = UKismetMathLibrary::NormalizeAxis( RootYawOffset - TIPYawDelta );
 
-        const float Turning{ GetCurveValue(TEXT("Turning")) };
+        const float Turning{ Snapshot.TurningCurve };
         if (Turning > 0)
         {
             bTurningInPlace = true;
             RotationCurveLastFrame = RotationCurve;
-            RotationCurve = GetCurveValue(TEXT("Rotation"));
+            RotationCurve = Snapshot.RotationCurve;
             const float DeltaRotation{ RotationCurve - RotationCurveLastFrame };
 
             //! RootYawOffset > 0 => Turning Left || RootYawOffset < 0 => Turning Right
@@ -201,9 +237,9 @@ void UShooterAnimInstance::TurnInPlace()
 
 void UShooterAnimInstance::Lean(float DeltaTime)
 {
-    if (ShooterCharacter == nullptr) return; 
+    if (!Snapshot.bValid) return; 
     CharacterRotationLastFrame = CharacterRotation;
-    CharacterRotation = ShooterCharacter->GetActorRotation();
+    CharacterRotation = Snapshot.ActorRotation;
 
     FRotator Delta { UKismetMathLibrary::NormalizedDeltaRotator(CharacterRotation, CharacterRotationLastFrame) };
 
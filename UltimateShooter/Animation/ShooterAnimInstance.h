@@ -18,6 +18,26 @@ enum class EOffsetState : uint8
 	EOS_MAX UMETA(DisplayName = "DefaultMAX"),
 };
 
+//! Character state gathered on the game thread, read by the thread safe animation update
+struct FShooterAnimSnapshot
+{
+	bool bValid = false;
+	bool bReloading = false;
+	bool bEquipping = false;
+	bool bCrouching = false;
+	bool bAiming = false;
+	bool bShouldUseFABRIK = false;
+	bool bIsFalling = false;
+	bool bIsAccelerating = false;
+	bool bHasWeapon = false;
+	EWeaponType EquippedWeaponType = EWeaponType::EWT_DefaultMAX;
+	FVector Velocity = FVector::ZeroVector;
+	FRotator AimRotation = FRotator::ZeroRotator;
+	FRotator ActorRotation = FRotator::ZeroRotator;
+	float TurningCurve = 0.f;
+	float RotationCurve = 0.f;
+};
+
 /**
  * 
  */
@@ -28,11 +48,26 @@ class ULTIMATESHOOTER_API UShooterAnimInstance : public UAnimInstance
 public:
 	UShooterAnimInstance();
 
-	UFUNCTION(BlueprintCallable)
+	//! Kept for existing Anim Blueprints, properties are now updated in NativeThreadSafeUpdateAnimation
+	UFUNCTION(BlueprintCallable, meta = (DeprecatedFunction, DeprecationMessage = "Properties are updated natively, remove the call from the event graph"))
 	void UpdateAnimationProperties(float DeltaTime);
 
 	virtual void NativeInitializeAnimation() override;
 
+	/**
+	 * @brief Gathers the character state into Snapshot on the game thread
+	 * 
+	 * @param DeltaSeconds The time elapsed since the last frame.
+	 */
+	virtual void NativeUpdateAnimation(float DeltaSeconds) override;
+
+	/**
+	 * @brief Computes the animation properties from Snapshot, can run on a worker thread
+	 * 
+	 * @param DeltaSeconds The time elapsed since the last frame.
+	 */
+	virtual void NativeThreadSafeUpdateAnimation(float DeltaSeconds) override;
+
 protected:
 
 	//! Handle turning in place variables
@@ -45,6 +80,9 @@ private:
 	UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Category = Movement, meta = (AllowPrivateAccess = "true"))
 	class AShooterCharacter* ShooterCharacter;
 
+	//! Character state of this frame, written on the game thread only
+	FShooterAnimSnapshot Snapshot;
+
 	//! The speed of the character
 	UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Category = Movement, meta = (AllowPrivateAccess = "true"))
 	float Speed;
@@ -82,6 +120,14 @@ private:
 	
 	//! Rotation curve value last frame
 	float RotationCurveLastFrame;
+
+	//! Name of the curve that is above 0 while a turn in place animation plays, built once instead of every update
+	UPROPERTY(EditDefaultsOnly, Category = "Turn in Place", meta = (AllowPrivateAccess = "true"))
+	FName TurningCurveName;
+
+	//! Name of the curve holding the root rotation of the turn in place animation
+	UPROPERTY(EditDefaultsOnly, Category = "Turn in Place", meta = (AllowPrivateAccess = "true"))
+	FName RotationCurveName;
 	
 	//! The pitch of the aim rotation used for aim offset
 	UPROPERTY(VisibleAnywhere, BlueprintReadOnly,Category = "Turn in Place", meta = (AllowPrivateAccess = "true"))
@@ -9,26 +9,48 @@
 #include "EnemyController.h"
 #include "BehaviorTree/BlackboardComponent.h"
 #include "ShooterCharacter.h"
-#include "Components/SphereComponent.h"
+#include "ShooterPlayerController.h"
 #include "Components/CapsuleComponent.h"
-#include "Components/BoxComponent.h"
 #include "GameFramework/CharacterMovementComponent.h"
 #include "Engine/SkeletalMeshSocket.h"
 #include "UltimateShooter/Weapons/Ammo.h"
 #include "UltimateShooter/Weapons/Weapon.h"
 #include "UltimateShooter/GameModes/UltimateShooterGameModeBase.h"
+#include "UltimateShooter/Subsystems/ItemDataSubsystem.h"
+#include "UltimateShooter/Subsystems/EnemySignificanceSubsystem.h"
+#include "UltimateShooter/Subsystems/EnemyAggroSubsystem.h"
+#include "UltimateShooter/Subsystems/EnemyPoolSubsystem.h"
+#include "UltimateShooter/Subsystems/LootPoolSubsystem.h"
+#include "UltimateShooter/Subsystems/FXBudgetSubsystem.h"
+#include "UltimateShooter/Subsystems/SoundDispatchSubsystem.h"
+#include "UltimateShooter/Subsystems/DamagePipelineSubsystem.h"
+#include "UltimateShooter/Subsystems/EnemyArchetypeSubsystem.h"
+#include "UltimateShooter/Subsystems/SocketCacheSubsystem.h"
+#include "UltimateShooter/Characters/EnemyArchetype.h"
+#include "UltimateShooter/Components/MeleeTraceComponent.h"
+#include "BrainComponent.h"
+#include "UltimateShooter/UltimateShooter.h"
+
+DECLARE_CYCLE_STAT(TEXT("Classify Hit Zone"), STAT_ClassifyHitZone, STATGROUP_UltimateShooter);
+DECLARE_DWORD_COUNTER_STAT(TEXT("Hit Zone Lookups"), STAT_HitZoneLookups, STATGROUP_UltimateShooter);
 
 // Sets default values
 AEnemy::AEnemy() :
 	Health{100.f}, 
 	MaxHealth{100.f}, 
+	HeadZoneMultiplier{1.f},
+	TorsoZoneMultiplier{1.f},
+	LimbZoneMultiplier{1.f},
 	HealthBarDisplayTime{4.f}, 
 	bCanHitReact{true}, 
 	HitReactTimeMin{0.3f}, 
 	HitReactTimeMax{0.6f}, 
+	bBlueprintTick{false},
 	HitNumberDestroyTime{1.5f},
+	AgroRadius{1000.f},
 	bStunned{false}, 
 	StunChance{0.5f}, 
+	CombatRangeRadius{150.f},
 	AttackLFast{TEXT("AttackLFast")}, 
 	AttackRFast{TEXT("AttackRFast")}, 
 	AttackL{TEXT("AttackL")}, 
@@ -42,25 +64,26 @@ AEnemy::AEnemy() :
 	AttackWaitTime{1.f}, 
 	bDying{false},
 	IsLastHeadshot{false},
-	LootDropRate{0.1f}
+	Archetype{nullptr},
+	ResolvedArchetype{nullptr},
+	AttackSeed{0},
+	PickedAttackIndex{INDEX_NONE},
+	LootDropRate{0.1f},
+	DefaultMeshCollision{ECollisionEnabled::QueryAndPhysics},
+	DefaultCapsuleCollision{ECollisionEnabled::QueryAndPhysics},
+	SignificanceTier{ESignificanceTier::EST_High}
 {
  	// Set this character to call Tick() every frame.  You can turn this off to improve performance if you don't need it.
 	PrimaryActorTick.bCanEverTick = true;
+	//! Hit Numbers are moved by AShooterPlayerController, Tick is only enabled while Blueprint spawned Hit Numbers are alive
+	//! or when a Blueprint subclass has an Event Tick, see BeginPlay
+	PrimaryActorTick.bStartWithTickEnabled = false;
 
-	//! Create the Agro Sphere
-	AgroSphere = CreateDefaultSubobject<USphereComponent>(TEXT("Agro Sphere"));
-	AgroSphere->SetupAttachment(GetRootComponent());
+	//! Let the engine skip animation updates of distant and off-screen enemies
+	GetMesh()->bEnableUpdateRateOptimizations = true;
 
-	//! Create the Combat Range Sphere
-	CombatRangeSphere = CreateDefaultSubobject<USphereComponent>(TEXT("Combat Range Sphere"));
-	CombatRangeSphere->SetupAttachment(GetRootComponent());
-
-	//! Construct Left and Right collision boxes
-	LeftWeaponCollision = CreateDefaultSubobject<UBoxComponent>(TEXT("Left Weapon Box"));
-	LeftWeaponCollision->SetupAttachment(GetMesh(), FName("LeftWeaponBone"));
-
-	RightWeaponCollision = CreateDefaultSubobject<UBoxComponent>(TEXT("Right Weapon Box"));
-	RightWeaponCollision->SetupAttachment(GetMesh(), FName("RightWeaponBone"));	
+	//! Melee hits are found by sweeping LeftWeaponSocket and RightWeaponSocket
+	MeleeTrace = CreateDefaultSubobject<UMeleeTraceComponent>(TEXT("Melee Trace"));
 }
 
 // Called when the game starts or when spawned
@@ -70,49 +93,183 @@ void AEnemy::BeginPlay()
 
 	Health = MaxHealth;
 
-	AgroSphere->OnComponentBeginOverlap.AddDynamic(this, &AEnemy::AgroSphereOverlap);
+	//! Blueprint subclasses with an Event Tick keep ticking every frame like they did before
+	bBlueprintTick = GetClass()->IsFunctionImplementedInScript(GET_FUNCTION_NAME_CHECKED(AEnemy, ReceiveTick));
+	if (bBlueprintTick)
+	{
+		SetActorTickEnabled(true);
+	}
 
-	CombatRangeSphere->OnComponentBeginOverlap.AddDynamic(this, &AEnemy::CombatSphereOverlap);
-	CombatRangeSphere->OnComponentEndOverlap.AddDynamic(this, &AEnemy::CombatSphereEndOverlap);
+	//! The table is built once per mesh asset, so classifying a hit is only a bone index lookup
+	BoneHitZones = USocketCacheSubsystem::FindHitZones(this, GetMesh(), HeadBone, LimbBones);
 
-	//! Bind functions to overlap events for weapon boxes
-	LeftWeaponCollision->OnComponentBeginOverlap.AddDynamic(this, &AEnemy::OnLeftWeaponOverlap);
-	RightWeaponCollision->OnComponentBeginOverlap.AddDynamic(this, &AEnemy::OnRightWeaponOverlap);
-	
-	//! Set collision presets for weapon boxes
-	LeftWeaponCollision->SetCollisionEnabled(ECollisionEnabled::NoCollision);
-	LeftWeaponCollision->SetCollisionObjectType(ECollisionChannel::ECC_WorldDynamic);
-	LeftWeaponCollision->SetCollisionResponseToAllChannels(ECollisionResponse::ECR_Ignore);
-	LeftWeaponCollision->SetCollisionResponseToChannel(ECollisionChannel::ECC_Pawn, ECollisionResponse::ECR_Overlap);
-	
-	RightWeaponCollision->SetCollisionEnabled(ECollisionEnabled::NoCollision);
-	RightWeaponCollision->SetCollisionObjectType(ECollisionChannel::ECC_WorldDynamic);
-	RightWeaponCollision->SetCollisionResponseToAllChannels(ECollisionResponse::ECR_Ignore);
-	RightWeaponCollision->SetCollisionResponseToChannel(ECollisionChannel::ECC_Pawn, ECollisionResponse::ECR_Overlap);
+	MeleeTrace->OnMeleeHit.AddUObject(this, &AEnemy::OnWeaponHit);
 
 	GetMesh()->SetCollisionResponseToChannel(ECollisionChannel::ECC_Visibility, ECollisionResponse::ECR_Block);
 	GetMesh()->SetCollisionResponseToChannel(ECollisionChannel::ECC_Camera, ECollisionResponse::ECR_Ignore);
 
 	GetCapsuleComponent()->SetCollisionResponseToChannel(ECollisionChannel::ECC_Camera, ECollisionResponse::ECR_Ignore);
 
+	//! TakeDamage changes these on death, a pooled enemy gets them back in ActivateFromPool
+	DefaultMeshCollision = GetMesh()->GetCollisionEnabled();
+	DefaultCapsuleCollision = GetCapsuleComponent()->GetCollisionEnabled();
+	DefaultCapsuleResponses = GetCapsuleComponent()->GetCollisionResponseToChannels();
+
+	//! Attack and death sections are picked from the archetype shared by every enemy with the same type and sections
+	ResolveArchetype();
+	SeedAttackStream(AttackSeed);
+
 	//! Get AI Controller
 	EnemyController = Cast<AEnemyController>(GetController());
 
+	StartBehavior();
+
 	if (EnemyController)
 	{
-		EnemyController->GetBlackboardComponent()->SetValueAsBool(FName("CanAttack"), true);
+		EnemyController->RunBehaviorTree(BehaviorTree);
 	}
-	
+
+	RegisterWithSubsystems();
+}
+
+void AEnemy::EndPlay(const EEndPlayReason::Type EndPlayReason)
+{
+	UnregisterFromSubsystems();
+
+	Super::EndPlay(EndPlayReason);
+}
+
+void AEnemy::StartBehavior()
+{
+	if (EnemyController == nullptr) return;
+
+	EnemyController->SetCanAttack(true);
+
 	FVector WorldPatrolPoint = UKismetMathLibrary::TransformLocation(GetActorTransform(), PatrolPoint);
 	FVector WorldPatrolPoint2 = UKismetMathLibrary::TransformLocation(GetActorTransform(), PatrolPoint2);
 
+	EnemyController->SetPatrolPoints(WorldPatrolPoint, WorldPatrolPoint2);
+}
+
+void AEnemy::RegisterWithSubsystems()
+{
+	if (UEnemySignificanceSubsystem* Significance = UEnemySignificanceSubsystem::Get(this))
+	{
+		Significance->RegisterEnemy(this);
+	}
+
+	if (UEnemyAggroSubsystem* Aggro = UEnemyAggroSubsystem::Get(this))
+	{
+		Aggro->RegisterEnemy(this);
+	}
+}
+
+void AEnemy::UnregisterFromSubsystems()
+{
+	if (UEnemySignificanceSubsystem* Significance = UEnemySignificanceSubsystem::Get(this))
+	{
+		Significance->UnregisterEnemy(this);
+	}
+
+	if (UEnemyAggroSubsystem* Aggro = UEnemyAggroSubsystem::Get(this))
+	{
+		Aggro->UnregisterEnemy(this);
+	}
+}
+
+void AEnemy::DeactivateForPool()
+{
+	//! Already done for enemies that died, needed for enemies parked by UEnemyPoolSubsystem::Prewarm
+	UnregisterFromSubsystems();
+
+	AUltimateShooterGameModeBase* GameMode = GetWorld()->GetAuthGameMode<AUltimateShooterGameModeBase>();
+	if (GameMode != nullptr)
+	{
+		GameMode->UnregisterEnemy(this);
+	}
+
+	GetWorldTimerManager().ClearAllTimersForObject(this);
+
+	for (auto& HitPair : HitNumbers)
+	{
+		if (HitPair.Key)
+		{
+			HitPair.Key->RemoveFromParent();
+		}
+	}
+	HitNumbers.Empty();
+	HideHealthBar();
+
 	if (EnemyController)
 	{
-		EnemyController->GetBlackboardComponent()->SetValueAsVector(TEXT("PatrolPoint"), WorldPatrolPoint);
-		EnemyController->GetBlackboardComponent()->SetValueAsVector(TEXT("PatrolPoint2"), WorldPatrolPoint2);
+		EnemyController->StopMovement();
+		if (UBrainComponent* Brain = EnemyController->GetBrainComponent())
+		{
+			Brain->StopLogic(TEXT("Pooled"));
+		}
+	}
+
+	if (UAnimInstance* AnimInstance = GetMesh()->GetAnimInstance())
+	{
+		AnimInstance->StopAllMontages(0.f);
+	}
 
-		EnemyController->RunBehaviorTree(BehaviorTree);
+	GetCharacterMovement()->DisableMovement();
+	SetActorTickEnabled(false);
+	SetActorEnableCollision(false);
+	SetActorHiddenInGame(true);
+}
+
+void AEnemy::ActivateFromPool(const FTransform& Transform)
+{
+	SetActorTransform(Transform, false, nullptr, ETeleportType::ResetPhysics);
+
+	Health = MaxHealth;
+	bDying = false;
+	bStunned = false;
+	bInAttackRange = false;
+	bCanAttack = true;
+	bCanHitReact = true;
+	IsLastHeadshot = false;
+	//! A reused enemy starts the same stream again instead of continuing the one of its previous life
+	SeedAttackStream(AttackSeed);
+
+	GetMesh()->SetCollisionEnabled(DefaultMeshCollision);
+	GetCapsuleComponent()->SetCollisionEnabled(DefaultCapsuleCollision);
+	GetCapsuleComponent()->SetCollisionResponseToChannels(DefaultCapsuleResponses);
+	GetMesh()->bPauseAnims = false;
+	GetCharacterMovement()->SetMovementMode(EMovementMode::MOVE_Walking);
+
+	SetActorHiddenInGame(false);
+	SetActorEnableCollision(true);
+	SetActorTickEnabled(bBlueprintTick);
+
+	if (EnemyController)
+	{
+		EnemyController->SetDead(false);
+		//! Set when this enemy killed the player in its previous life
+		EnemyController->SetCharacterDead(false);
+		EnemyController->SetStunned(false);
+		EnemyController->SetInAttackRange(false);
+		EnemyController->SetTarget(nullptr);
 	}
+	StartBehavior();
+
+	if (EnemyController)
+	{
+		if (UBrainComponent* Brain = EnemyController->GetBrainComponent())
+		{
+			Brain->RestartLogic();
+		}
+	}
+
+	AUltimateShooterGameModeBase* GameMode = GetWorld()->GetAuthGameMode<AUltimateShooterGameModeBase>();
+	if (GameMode != nullptr)
+	{
+		GameMode->RegisterEnemy(this);
+	}
+
+	RegisterWithSubsystems();
 }
 
 void AEnemy::ShowHealthBar_Implementation()
@@ -126,9 +283,13 @@ void AEnemy::Die(AShooterCharacter* Character, bool Headshot)
 	if (bDying) return;
 	bDying = true;
 
+	//! Death montage has to play at full rate
+	UnregisterFromSubsystems();
+
 	AUltimateShooterGameModeBase* GameMode = GetWorld()->GetAuthGameMode<AUltimateShooterGameModeBase>();
 	if(GameMode != nullptr)
 	{
+		GameMode->UnregisterEnemy(this);
 		GameMode->CharacterKilled(this);
 	}
 
@@ -136,85 +297,46 @@ void AEnemy::Die(AShooterCharacter* Character, bool Headshot)
 	DeactivateRightWeapon();
 	HideHealthBar();
 
-	if (Character && EnemyType.IsEqual(FName("Grux")) || EnemyType.IsEqual(FName("Minion")))
+	FName SectionName{ NAME_None };
+	if (ResolvedArchetype && ResolvedArchetype->HasDirectionalDeath())
 	{
-		FVector DirectionToCharacter = Character->GetActorLocation() - GetActorLocation();
-		DirectionToCharacter.Normalize();
+		bool bFromFront{ true };
+		if (Character)
+		{
+			FVector DirectionToCharacter = Character->GetActorLocation() - GetActorLocation();
+			DirectionToCharacter.Normalize();
 
-		FVector Forward = GetActorForwardVector();
+			bFromFront = FVector::DotProduct(GetActorForwardVector(), DirectionToCharacter) > 0;
+		}
 
-		float ForwardDot = FVector::DotProduct(Forward, DirectionToCharacter);
-		FName SectionName;
+		const bool bHeadshotDeath{ IsLastHeadshot && ResolvedArchetype->HasHeadshotDeath() };
+		SectionName = ResolvedArchetype->GetDeathSection(bFromFront, bHeadshotDeath);
 
-		if (EnemyType.IsEqual(FName("Minion")))
+		if (bHeadshotDeath)
 		{
-			if (IsLastHeadshot)
-			{
-				SectionName = FName("DeathHeadshot");
-				FTransform SocketTransform = GetMesh()->GetSocketTransform(FName("HeadExplosion"));
-				UGameplayStatics::SpawnEmitterAtLocation(GetWorld(), MinionDeathParticles, SocketTransform);
-				if (HeadshotExplosionSound)
-				{
-					UGameplayStatics::PlaySoundAtLocation(this, HeadshotExplosionSound, SocketTransform.GetLocation(), 1.f);
-				}
-			}
-			else
-			{
-				if (ForwardDot > 0)
-				{
-					int Number = FMath::RandRange(0,1);
-					if (Number == 0)
-					{
-						SectionName = FName("DeathFront");
-						DeathDirection = EHitDirection::Front;
-					}
-					else
-					{
-						SectionName = FName("DeathFrontTwist");
-						DeathDirection = EHitDirection::Front;
-					}
-				}
-				else
-				{
-					SectionName = FName("DeathBack");
-					DeathDirection = EHitDirection::Back;
-				}
-			}
+			const FTransform SocketTransform = GetHeadshotTransform();
+			UFXBudgetSubsystem::SpawnEmitterAtLocation(this, ResolvedArchetype->GetHeadshotParticles(), SocketTransform);
+			USoundDispatchSubsystem::PlaySoundAtLocation(this, ResolvedArchetype->GetHeadshotSound(), SocketTransform.GetLocation(), ESoundCategory::ESC_Explosion);
 		}
-		else if (EnemyType.IsEqual(FName("Grux")))
-		{
-			if (ForwardDot > 0)
-			{
-				SectionName = FName("DeathFront");
-				DeathDirection = EHitDirection::Front;
-			}
-			else
-			{
-				SectionName = FName("DeathBack");
-				DeathDirection = EHitDirection::Back;
-			}
-		}
-		
-		UAnimInstance* AnimInstance = GetMesh()->GetAnimInstance();
-		if (AnimInstance && DeathMontage)
+		else
 		{
-			AnimInstance->Montage_Play(DeathMontage);
-			AnimInstance->Montage_JumpToSection(SectionName, DeathMontage);
+			DeathDirection = bFromFront ? EHitDirection::Front : EHitDirection::Back;
 		}
-
 	}
-	else if (EnemyType.IsEqual(FName("Khaimera")))
+
+	UAnimInstance* AnimInstance = GetMesh()->GetAnimInstance();
+	if (AnimInstance && DeathMontage)
 	{
-		UAnimInstance* AnimInstance = GetMesh()->GetAnimInstance();
-		if (AnimInstance && DeathMontage)
+		AnimInstance->Montage_Play(DeathMontage);
+		if (!SectionName.IsNone())
 		{
-			AnimInstance->Montage_Play(DeathMontage);
+			AnimInstance->Montage_JumpToSection(SectionName, DeathMontage);
 		}
 	}
 
 	if (EnemyController)
 	{
-		EnemyController->GetBlackboardComponent()->SetValueAsBool(FName("Dead"), true);
+		EnemyController->SetDead(true);
 		EnemyController->StopMovement();
 	}
 
@@ -240,17 +362,15 @@ void AEnemy::PlayHitMontage(FName Section, float PlayRate)
 
 void AEnemy::PlayAttackMontage(FName Section, float PlayRate)
 {
+	//! Every attack is on cooldown or out of range, Montage_JumpToSection would leave the montage playing from the start
+	if (Section.IsNone()) return;
+
+	StartAttackCooldown(Section);
+
 	UAnimInstance* AnimInstance = GetMesh()->GetAnimInstance();
 	if (AnimInstance)
 	{
-		if (EnemyType.IsEqual(FName("Minion")))
-		{
-			AnimInstance->Montage_Play(AttackMontage, 1.5f);
-		}
-		else
-		{
-			AnimInstance->Montage_Play(AttackMontage, PlayRate);
-		}
+		AnimInstance->Montage_Play(AttackMontage, ResolvedArchetype ? ResolvedArchetype->GetAttackPlayRate(PlayRate) : PlayRate);
 		AnimInstance->Montage_JumpToSection(Section, AttackMontage);
 	}
 
@@ -259,59 +379,137 @@ void AEnemy::PlayAttackMontage(FName Section, float PlayRate)
 
 	if (EnemyController)
 	{
-		EnemyController->GetBlackboardComponent()->SetValueAsBool(FName("CanAttack"), false);
+		EnemyController->SetCanAttack(false);
+	}
+}
+
+FName AEnemy::GetAttackSectionName() const
+{
+	if (ResolvedArchetype == nullptr) return NAME_None;
+
+	float Distance{ 0.f };
+	const AActor* Target = EnemyController ? Cast<AActor>(EnemyController->GetTarget()) : nullptr;
+	if (Target)
+	{
+		Distance = GetDistanceTo(Target);
 	}
+
+	//! Picks from a copy, the same attack is returned until StartAttackCooldown commits the copy
+	PickedAttackStream = AttackStream;
+	PickedAttackIndex = ResolvedArchetype->PickAttack(PickedAttackStream, Distance, GetWorld()->GetTimeSeconds(), AttackReadyTimes);
+	const FEnemyAttack* Attack = ResolvedArchetype->GetAttack(PickedAttackIndex);
+	return Attack ? Attack->Section : NAME_None;
 }
 
-FName AEnemy::GetAttackSectionName()
+void AEnemy::StartAttackCooldown(FName Section)
 {
-	FName SectionName;
-	if (AttackCFast.IsEqual(FName("None")))
+	if (ResolvedArchetype == nullptr || Section.IsNone()) return;
+
+	int32 AttackIndex{ INDEX_NONE };
+	const FEnemyAttack* PickedAttack = ResolvedArchetype->GetAttack(PickedAttackIndex);
+	if (PickedAttack && PickedAttack->Section == Section)
 	{
-		const int32 SectionNum{ FMath::RandRange(1,4) };
-		switch(SectionNum)
+		//! Next pick continues after every draw this one used
+		AttackIndex = PickedAttackIndex;
+		AttackStream = PickedAttackStream;
+	}
+	else
+	{
+		for (int32 Index = 0; Index < ResolvedArchetype->GetNumAttacks(); Index++)
 		{
-			case 1:
-				SectionName = AttackLFast;
-				break;
-			case 2:
-				SectionName = AttackRFast;
-				break;
-			case 3:
-				SectionName = AttackL;
-				break; 
-			case 4:
-				SectionName = AttackR;
+			if (ResolvedArchetype->GetAttack(Index)->Section == Section)
+			{
+				AttackIndex = Index;
 				break;
+			}
 		}
 	}
-	else
+	PickedAttackIndex = INDEX_NONE;
+
+	if (AttackReadyTimes.IsValidIndex(AttackIndex))
 	{
-		const int32 SectionNum{ FMath::RandRange(1,6) };
-		switch(SectionNum)
+		AttackReadyTimes[AttackIndex] = GetWorld()->GetTimeSeconds() + ResolvedArchetype->GetAttack(AttackIndex)->Cooldown;
+	}
+}
+
+FTransform AEnemy::GetHeadshotTransform()
+{
+	const FName SocketName = ResolvedArchetype ? ResolvedArchetype->GetHeadshotSocket() : NAME_None;
+	if (const USkeletalMeshSocket* HeadshotSocket = HeadshotSocketCache.Get(this, GetMesh(), SocketName))
+	{
+		return HeadshotSocket->GetSocketTransform(GetMesh());
+	}
+
+	const int32 BoneIndex = HeadshotBoneCache.Get(this, GetMesh(), SocketName);
+	return BoneIndex != INDEX_NONE ? GetMesh()->GetBoneTransform(BoneIndex) : GetMesh()->GetComponentTransform();
+}
+
+void AEnemy::SeedAttackStream(int32 Seed)
+{
+	AttackSeed = Seed;
+	//! Hash of the name string, the FName index depends on the order names were created in and changes between runs
+	AttackStream.Initialize(AttackSeed != 0 ? AttackSeed : static_cast<int32>(FCrc::StrCrc32(*GetName())));
+	AttackReadyTimes.Init(0.f, ResolvedArchetype ? ResolvedArchetype->GetNumAttacks() : 0);
+	PickedAttackIndex = INDEX_NONE;
+}
+
+UEnemyArchetype* AEnemy::ResolveArchetype()
+{
+	if (ResolvedArchetype) return ResolvedArchetype;
+
+	UEnemyArchetypeSubsystem* Archetypes = UEnemyArchetypeSubsystem::Get(this);
+	ResolvedArchetype = Archetypes ? Archetypes->ResolveArchetype(this) : Archetype;
+	if (ResolvedArchetype == nullptr)
+	{
+		ResolvedArchetype = CreateDefaultArchetype(this);
+	}
+	return ResolvedArchetype;
+}
+
+EEnemyType AEnemy::GetArchetypeEnemyType()
+{
+	return ResolveArchetype()->GetEnemyType();
+}
+
+UEnemyArchetype* AEnemy::CreateDefaultArchetype(UObject* Outer) const
+{
+	UEnemyArchetype* DefaultArchetype = NewObject<UEnemyArchetype>(Outer);
+
+	for (const FName& Section : { AttackLFast, AttackRFast, AttackCFast, AttackL, AttackR, AttackC })
+	{
+		if (!Section.IsNone())
 		{
-			case 1:
-				SectionName = AttackLFast;
-				break;
-			case 2:
-				SectionName = AttackRFast;
-				break;
-			case 3:
-				SectionName = AttackCFast;
-				break; 
-			case 4:
-				SectionName = AttackL;
-			break;
-			case 5:
-				SectionName = AttackR;
-				break;
-			case 6:
-				SectionName = AttackC;
+			DefaultArchetype->Attacks.AddDefaulted_GetRef().Section = Section;
 		}
 	}
-	
 
-	return SectionName;
+	//! Runs once per FDefaultArchetypeKey, the names are only compared here
+	if (EnemyType == FName("Grux"))
+	{
+		DefaultArchetype->EnemyType = EEnemyType::EET_Grux;
+		DefaultArchetype->DeathFrontSections.Add(FName("DeathFront"));
+		DefaultArchetype->DeathBackSections.Add(FName("DeathBack"));
+	}
+	else if (EnemyType == FName("Minion"))
+	{
+		DefaultArchetype->EnemyType = EEnemyType::EET_Minion;
+		DefaultArchetype->bOverrideAttackPlayRate = true;
+		DefaultArchetype->AttackPlayRate = 1.5f;
+		DefaultArchetype->DeathFrontSections.Add(FName("DeathFront"));
+		DefaultArchetype->DeathFrontSections.Add(FName("DeathFrontTwist"));
+		DefaultArchetype->DeathBackSections.Add(FName("DeathBack"));
+		DefaultArchetype->HeadshotDeathSection = FName("DeathHeadshot");
+		DefaultArchetype->HeadshotSocket = FName("HeadExplosion");
+		DefaultArchetype->HeadshotParticles = MinionDeathParticles;
+		DefaultArchetype->HeadshotSound = HeadshotExplosionSound;
+	}
+	else if (EnemyType == FName("Khaimera"))
+	{
+		DefaultArchetype->EnemyType = EEnemyType::EET_Khaimera;
+	}
+
+	DefaultArchetype->BuildAttackTable();
+	return DefaultArchetype;
 }
 
 FName AEnemy::GetHitReactDirection(const FHitResult& HitResult)
@@ -347,6 +545,70 @@ FName AEnemy::GetHitReactDirection(const FHitResult& HitResult)
 	}
 }
 
+EHitZone AEnemy::GetHitZone(FName BoneName) const
+{
+	SCOPE_CYCLE_COUNTER(STAT_ClassifyHitZone);
+	INC_DWORD_STAT(STAT_HitZoneLookups);
+
+	const int32 BoneIndex = GetMesh()->GetBoneIndex(BoneName);
+	return BoneHitZones.IsValid() && BoneHitZones->IsValidIndex(BoneIndex) ? (*BoneHitZones)[BoneIndex] : EHitZone::EHZ_Torso;
+}
+
+float AEnemy::GetHitZoneMultiplier(EHitZone Zone) const
+{
+	switch (Zone)
+	{
+		case EHitZone::EHZ_Head:
+			return HeadZoneMultiplier;
+		case EHitZone::EHZ_Limb:
+			return LimbZoneMultiplier;
+		default:
+			return TorsoZoneMultiplier;
+	}
+}
+
+void AEnemy::SetSignificanceTier(ESignificanceTier Tier)
+{
+	if (Tier == SignificanceTier || Tier == ESignificanceTier::EST_MAX) return;
+	SignificanceTier = Tier;
+
+	//! Tick intervals indexed by ESignificanceTier
+	static constexpr float ActorTickIntervals[] = { 0.f, 0.1f, 0.25f, 1.f };
+	static constexpr float MeshTickIntervals[] = { 0.f, 1.f / 30.f, 1.f / 15.f, 0.25f };
+	static constexpr float MovementTickIntervals[] = { 0.f, 0.f, 1.f / 30.f, 0.1f };
+	const int32 Index = static_cast<int32>(Tier);
+
+	SetActorTickInterval(ActorTickIntervals[Index]);
+	GetMesh()->SetComponentTickInterval(MeshTickIntervals[Index]);
+	GetCharacterMovement()->SetComponentTickInterval(MovementTickIntervals[Index]);
+
+	if (Tier == ESignificanceTier::EST_High)
+	{
+		GetMesh()->VisibilityBasedAnimTickOption = EVisibilityBasedAnimTickOption::AlwaysTickPoseAndRefreshBones;
+	}
+	else if (Tier == ESignificanceTier::EST_Medium)
+	{
+		GetMesh()->VisibilityBasedAnimTickOption = EVisibilityBasedAnimTickOption::AlwaysTickPose;
+	}
+	else
+	{
+		GetMesh()->VisibilityBasedAnimTickOption = EVisibilityBasedAnimTickOption::OnlyTickMontagesWhenNotRendered;
+	}
+
+	if (EnemyController)
+	{
+		//! The behavior tree only ticks when its tasks and services need it, Dormant enemies stop it altogether
+		EnemyController->SetAIDormant(Tier == ESignificanceTier::EST_Dormant);
+	}
+}
+
+bool AEnemy::IsInCombat() const
+{
+	if (bInAttackRange || bStunned) return true;
+
+	return EnemyController && EnemyController->GetTarget() != nullptr;
+}
+
 void AEnemy::ResetHitReactTimer()
 {
 	bCanHitReact = true;
@@ -355,6 +617,7 @@ void AEnemy::ResetHitReactTimer()
 void AEnemy::StoreHitNumber(UUserWidget* HitNumber, FVector Location)
 {
 	HitNumbers.Add(HitNumber,Location);
+	SetActorTickEnabled(true);
 
 	FTimerHandle HitNumberTimer;
 	FTimerDelegate HitTimerDelegate;
@@ -367,6 +630,23 @@ void AEnemy::DestroyHitNumber(UUserWidget* HitNumber)
 {
 	HitNumbers.Remove(HitNumber);
 	HitNumber->RemoveFromParent();
+
+	if (HitNumbers.Num() == 0 && !bBlueprintTick)
+	{
+		SetActorTickEnabled(false);
+	}
+}
+
+void AEnemy::SpawnHitNumber(int32 Damage, FVector HitLocation, bool HeadShot)
+{
+	//! Set before the damage is applied, Die reads it for the headshot death. The pooled path skips the Blueprint event
+	IsLastHeadshot = HeadShot;
+
+	AShooterPlayerController* PlayerController = Cast<AShooterPlayerController>(UGameplayStatics::GetPlayerController(this, 0));
+	if (PlayerController && PlayerController->ShowHitNumber(Damage, HitLocation, HeadShot)) return;
+
+	//! No pool, Blueprint creates the widget and calls StoreHitNumber
+	ShowHitNumber(Damage, HitLocation, HeadShot);
 }
 
 void AEnemy::UpdateHitNumbers()
@@ -404,12 +684,12 @@ void AEnemy::BulletHit_Implementation(FHitResult HitResult, AActor* Shooter, ACo
 
 	if (ImpactParticles)
 	{
-		UGameplayStatics::SpawnEmitterAtLocation(GetWorld(), ImpactParticles, HitResult.Location, FRotator(0.f), true);
+		UFXBudgetSubsystem::SpawnEmitterAtLocation(this, ImpactParticles, FTransform(HitResult.Location));
 	}
 
 	if (ImpactSound)
 	{
-		UGameplayStatics::PlaySoundAtLocation(this, ImpactSound, HitResult.Location);
+		USoundDispatchSubsystem::PlaySoundAtLocation(this, ImpactSound, HitResult.Location, ESoundCategory::ESC_Impact);
 	}
 
 	const float Stunned = FMath::FRandRange(0.f, 1.f);
@@ -430,7 +710,7 @@ float AEnemy::TakeDamage(float DamageAmount, struct FDamageEvent const & DamageE
 {
 	if (EnemyController)
 	{
-		EnemyController->GetBlackboardComponent()->SetValueAsObject(FName("Target"), DamageCauser);
+		EnemyController->SetTarget(DamageCauser);
 	}
 
 	if (Health - DamageAmount <= 0.f)
@@ -454,20 +734,21 @@ float AEnemy::TakeDamage(float DamageAmount, struct FDamageEvent const & DamageE
 	return DamageAmount;
 }
 
-void AEnemy::AgroSphereOverlap(UPrimitiveComponent* OverlappedComponent, AActor* OtherActor,
-	UPrimitiveComponent* OtherComp, int32 OtherBodyIndex, bool bFromSweep, const FHitResult& SweepResult)
+void AEnemy::AgroRangeEntered(AShooterCharacter* Character)
 {
-	if (OtherActor == nullptr) return;
+	if (Character == nullptr) return;
 
-	AShooterCharacter* Character = Cast<AShooterCharacter>(OtherActor);
-	if (Character)
+	if (EnemyController)
 	{
-		if (EnemyController)
+		EnemyController->SetTarget(Character);
+	}
+
+	//! Dropped weapon type is random, stream in all of them before this enemy can die
+	if (WeaponClass)
+	{
+		if (UItemDataSubsystem* ItemData = UItemDataSubsystem::Get(this))
 		{
-			if (EnemyController->GetBlackboardComponent())
-			{
-				EnemyController->GetBlackboardComponent()->SetValueAsObject(TEXT("Target"), Character);
-			}
+			ItemData->RequestAllWeaponAssets();
 		}
 	}
 }
@@ -478,108 +759,82 @@ void AEnemy::SetStunned(bool Stunned)
 
 	if (EnemyController)
 	{
-		EnemyController->GetBlackboardComponent()->SetValueAsBool(TEXT("Stunned"), Stunned);
+		EnemyController->SetStunned(Stunned);
 	}
 }
 
-void AEnemy::CombatSphereOverlap(UPrimitiveComponent* OverlappedComponent, AActor* OtherActor,
-	UPrimitiveComponent* OtherComp, int32 OtherBodyIndex, bool bFromSweep, const FHitResult& SweepResult)
+void AEnemy::CombatRangeEntered(AShooterCharacter* Character)
 {
-	if (OtherActor == nullptr) return;
-	
-	AShooterCharacter* Character = Cast<AShooterCharacter>(OtherActor);
-	if (Character)
-	{
-		bInAttackRange = true;	
-		if (EnemyController)
-		{
-			EnemyController->GetBlackboardComponent()->SetValueAsBool(TEXT("InAttackRange"), true);
-		}
-	}
-}
+	if (Character == nullptr) return;
 
-void AEnemy::CombatSphereEndOverlap(UPrimitiveComponent* OverlappedComponent, AActor* OtherActor,
-	UPrimitiveComponent* OtherComp, int32 OtherBodyIndex)
-{
-	if (OtherActor == nullptr) return;
-	
-	AShooterCharacter* Character = Cast<AShooterCharacter>(OtherActor);
-	if (Character)
+	bInAttackRange = true;
+	if (EnemyController)
 	{
-		bInAttackRange = false;	
-		if (EnemyController)
-		{
-			EnemyController->GetBlackboardComponent()->SetValueAsBool(TEXT("InAttackRange"),false);
-		}
-	}	
+		EnemyController->SetInAttackRange(true);
+	}
 }
 
-void AEnemy::OnLeftWeaponOverlap(UPrimitiveComponent* OverlappedComponent, AActor* OtherActor,
-	UPrimitiveComponent* OtherComp, int32 OtherBodyIndex, bool bFromSweep, const FHitResult& SweepResult)
+void AEnemy::CombatRangeExited(AShooterCharacter* Character)
 {
-	AShooterCharacter* Character = Cast<AShooterCharacter>(OtherActor);
-	if (Character)
+	bInAttackRange = false;
+	if (EnemyController)
 	{
-		EHitDirection HitDirection;
-		GetCharacterDirection(Character, HitDirection);
-
-		DoDamage(Character);
-
-		EHitDirection MontageDirection;
-		SpawnBlood(Character, HitDirection, true, MontageDirection);
-
-		StunCharacter(Character, MontageDirection);
+		EnemyController->SetInAttackRange(false);
 	}
 }
 
-void AEnemy::OnRightWeaponOverlap(UPrimitiveComponent* OverlappedComponent, AActor* OtherActor,
-	UPrimitiveComponent* OtherComp, int32 OtherBodyIndex, bool bFromSweep, const FHitResult& SweepResult)
+void AEnemy::OnWeaponHit(AActor* Victim, FName SocketName, const FHitResult& Hit)
 {
-	AShooterCharacter* Character = Cast<AShooterCharacter>(OtherActor);
+	AShooterCharacter* Character = Cast<AShooterCharacter>(Victim);
 	if (Character)
 	{
 		EHitDirection HitDirection;
 		GetCharacterDirection(Character, HitDirection);
-		
-		DoDamage(Character);
-		
+
 		EHitDirection MontageDirection;
-		SpawnBlood(Character, HitDirection, false, MontageDirection);
+		SpawnBlood(Character, HitDirection, SocketName == LeftWeaponSocket, MontageDirection);
 
-		StunCharacter(Character, MontageDirection);
+		DoDamage(Character, MontageDirection);
 	}
-
 }
 
 void AEnemy::ActivateLeftWeapon()
 {
-	LeftWeaponCollision->SetCollisionEnabled(ECollisionEnabled::QueryOnly);
+	MeleeTrace->BeginSwing(LeftWeaponSocket);
 }
 
 void AEnemy::DeactivateLeftWeapon()
 {
-	LeftWeaponCollision->SetCollisionEnabled(ECollisionEnabled::NoCollision);
+	MeleeTrace->EndSwing(LeftWeaponSocket);
 }
 
 void AEnemy::ActivateRightWeapon()
 {
-	RightWeaponCollision->SetCollisionEnabled(ECollisionEnabled::QueryOnly);
+	MeleeTrace->BeginSwing(RightWeaponSocket);
 }
 
 void AEnemy::DeactivateRightWeapon()
 {
-	RightWeaponCollision->SetCollisionEnabled(ECollisionEnabled::NoCollision);
+	MeleeTrace->EndSwing(RightWeaponSocket);
 }
 
-void AEnemy::DoDamage(AShooterCharacter* Victim)
+void AEnemy::DoDamage(AShooterCharacter* Victim, EHitDirection StunDirection)
 {
 	if (Victim == nullptr) return;
 
-	UGameplayStatics::ApplyDamage(Victim, BaseDamage, EnemyController, this, UDamageType::StaticClass());
+	//! Stun waits for the damage, so a player this hit killed is not stunned
+	UDamagePipelineSubsystem::QueueDamage(this, Victim, BaseDamage, EnemyController, this,
+		[WeakThis = TWeakObjectPtr<AEnemy>(this), WeakVictim = TWeakObjectPtr<AShooterCharacter>(Victim), StunDirection]()
+		{
+			if (WeakThis.IsValid())
+			{
+				WeakThis->StunCharacter(WeakVictim.Get(), StunDirection);
+			}
+		});
 
 	if (Victim->GetMeleImpactSound())
 	{
-		UGameplayStatics::PlaySoundAtLocation(this, Victim->GetMeleImpactSound(), Victim->GetActorLocation() );
+		USoundDispatchSubsystem::PlaySoundAtLocation(this, Victim->GetMeleImpactSound(), Victim->GetActorLocation(), ESoundCategory::ESC_Melee);
 	}
 }
 
@@ -596,48 +851,48 @@ void AEnemy::SpawnBlood(AShooterCharacter* Victim, EHitDirection Direction, bool
 			case EHitDirection::Front:
 				if (LeftWeapon)
 				{
-					CharacterBloodSocket = Victim->GetMesh()->GetSocketByName(Victim->GetRightBloodSocketName());
+					CharacterBloodSocket = Victim->GetBloodSocket(EHitDirection::Right);
 					MontageDirection = EHitDirection::Right;
 				}
 				else
 				{
-					CharacterBloodSocket = Victim->GetMesh()->GetSocketByName(Victim->GetLeftBloodSocketName());
+					CharacterBloodSocket = Victim->GetBloodSocket(EHitDirection::Left);
 					MontageDirection = EHitDirection::Left;
 				}
 				break;
 			case EHitDirection::Back:
 				if (LeftWeapon)
 				{
-					CharacterBloodSocket = Victim->GetMesh()->GetSocketByName(Victim->GetLeftBloodSocketName());
+					CharacterBloodSocket = Victim->GetBloodSocket(EHitDirection::Left);
 					MontageDirection = EHitDirection::Left;
 				}
 				else
 				{
-					CharacterBloodSocket = Victim->GetMesh()->GetSocketByName(Victim->GetRightBloodSocketName());
+					CharacterBloodSocket = Victim->GetBloodSocket(EHitDirection::Right);
 					MontageDirection = EHitDirection::Right;
 				}
 			break;
 			case EHitDirection::Right:
 				if (LeftWeapon)
 				{
-					CharacterBloodSocket = Victim->GetMesh()->GetSocketByName(Victim->GetBackBloodSocketName());
+					CharacterBloodSocket = Victim->GetBloodSocket(EHitDirection::Back);
 					MontageDirection = EHitDirection::Back;
 				}
 				else
 				{
-					CharacterBloodSocket = Victim->GetMesh()->GetSocketByName(Victim->GetForwardBloodSocketName());
+					CharacterBloodSocket = Victim->GetBloodSocket(EHitDirection::Front);
 					MontageDirection = EHitDirection::Front;
 				}
 				break;
 			case EHitDirection::Left:
 				if (LeftWeapon)
 				{
-					CharacterBloodSocket = Victim->GetMesh()->GetSocketByName(Victim->GetForwardBloodSocketName());
+					CharacterBloodSocket = Victim->GetBloodSocket(EHitDirection::Front);
 					MontageDirection = EHitDirection::Front;
 				}
 				else
 				{
-					CharacterBloodSocket = Victim->GetMesh()->GetSocketByName(Victim->GetBackBloodSocketName());
+					CharacterBloodSocket = Victim->GetBloodSocket(EHitDirection::Back);
 					MontageDirection = EHitDirection::Back;
 				}
 			break;
@@ -648,7 +903,7 @@ void AEnemy::SpawnBlood(AShooterCharacter* Victim, EHitDirection Direction, bool
 			const FTransform SocketTransform{ CharacterBloodSocket->GetSocketTransform(Victim->GetMesh()) };
 			if (Victim->GetBloodParticles())
 			{
-				UGameplayStatics::SpawnEmitterAtLocation(GetWorld(), Victim->GetBloodParticles(), SocketTransform);
+				UFXBudgetSubsystem::SpawnEmitterAtLocation(this, Victim->GetBloodParticles(), SocketTransform);
 			}
 		} 
 	} 
@@ -701,13 +956,21 @@ void AEnemy::ResetCanAttack()
 
 	if (EnemyController)
 	{
-		EnemyController->GetBlackboardComponent()->SetValueAsBool(FName("CanAttack"), true);
+		EnemyController->SetCanAttack(true);
 	}
 }
 
 void AEnemy::FinishDeath()
 {
-	Destroy();
+	UEnemyPoolSubsystem* Pool = UEnemyPoolSubsystem::Get(this);
+	if (Pool)
+	{
+		Pool->ReleaseEnemy(this);
+	}
+	else
+	{
+		Destroy();
+	}
 }
 
 void AEnemy::FreezeInDeathPose()
@@ -723,32 +986,36 @@ void AEnemy::SpawnWeaponAndAmmo()
 
 	FVector SpawnLocation = GetActorLocation() + FVector(0.f, 0.f, 55.f); //! (0.f, 0.f, CapsuleComponentHalfHeight*1.5f)
 	FRotator SpawnRotation = FRotator(0.f, FMath::RandRange(-160.f, 160.f), 0.f);
+
+	//! Reuses parked loot actors, spawns directly only if there is no pool
+	ULootPoolSubsystem* LootPool = ULootPoolSubsystem::Get(this);
 	
 	if (WeaponClass)
 	{
 		float DropPercent = FMath::FRandRange(0.f,1.f);
 		if (DropPercent <= LootDropRate)
 		{	
-			Weapon = GetWorld()->SpawnActor<AWeapon>(WeaponClass, SpawnLocation, SpawnRotation);
-			Weapon->SetItemState(EItemState::EIS_Falling);
-			Weapon->SetUpSpawnedWeapon();
-			Weapon->ThrowWeapon();
+			Weapon = LootPool ? LootPool->SpawnLoot<AWeapon>(WeaponClass, SpawnLocation, SpawnRotation) :
+				GetWorld()->SpawnActor<AWeapon>(WeaponClass, SpawnLocation, SpawnRotation);
+			if (Weapon)
+			{
+				Weapon->SetItemState(EItemState::EIS_Falling);
+				Weapon->SetUpSpawnedWeapon();
+				Weapon->ThrowWeapon();
+			}
 		}
 	}
 
 	if (AmmoSMGClass && AmmoARClass)
 	{
-		int Num = FMath::RandRange(1,2);
-		if (Num == 1)
-		{
-			Ammo = GetWorld()->SpawnActor<AAmmo>(AmmoSMGClass, SpawnLocation, SpawnRotation);
-		}
-		else
+		TSubclassOf<AAmmo> AmmoClass = FMath::RandRange(1,2) == 1 ? AmmoSMGClass : AmmoARClass;
+		Ammo = LootPool ? LootPool->SpawnLoot<AAmmo>(AmmoClass, SpawnLocation, SpawnRotation) :
+			GetWorld()->SpawnActor<AAmmo>(AmmoClass, SpawnLocation, SpawnRotation);
+
+		if (Ammo)
 		{
-			Ammo = GetWorld()->SpawnActor<AAmmo>(AmmoARClass, SpawnLocation, SpawnRotation);
+			Ammo->ThrowAmmo();
 		}
-
-		Ammo->ThrowAmmo();
 	}
 
 }
\ No newline at end of file
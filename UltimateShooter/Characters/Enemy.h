@@ -6,6 +6,10 @@
 #include "GameFramework/Character.h"
 #include "UltimateShooter/Interfaces/BulletHitInterface.h"
 #include "UltimateShooter/Enums/HitDirection.h"
+#include "UltimateShooter/Enums/HitZone.h"
+#include "UltimateShooter/Enums/EnemyType.h"
+#include "UltimateShooter/Enums/SignificanceTier.h"
+#include "UltimateShooter/Subsystems/SocketCacheSubsystem.h"
 #include "Enemy.generated.h"
 
 
@@ -28,6 +32,33 @@ protected:
 	 */
 	virtual void BeginPlay() override;
 
+	/**
+	 * @brief Called when the enemy is removed from the world.
+	 * 
+	 * Unregisters the enemy from UEnemySignificanceSubsystem.
+	 * 
+	 * @param EndPlayReason Why the enemy is leaving play
+	 */
+	virtual void EndPlay(const EEndPlayReason::Type EndPlayReason) override;
+
+	/**
+	 * @brief Writes the start of combat state and the patrol points, relative to the current transform, to the blackboard
+	 * 
+	 */
+	void StartBehavior();
+
+	/**
+	 * @brief Registers the enemy with UEnemySignificanceSubsystem and UEnemyAggroSubsystem
+	 * 
+	 */
+	void RegisterWithSubsystems();
+
+	/**
+	 * @brief Unregisters the enemy from UEnemySignificanceSubsystem and UEnemyAggroSubsystem
+	 * 
+	 */
+	void UnregisterFromSubsystems();
+
 	/**
 	 * @brief Declared as Blueprint Native Event and has it's implementation in blueprint.
 	 * 
@@ -125,26 +156,6 @@ protected:
 	 */
 	void UpdateHitNumbers();
 
-	//! Called when something overlaps with the agro sphere
-	/**
-	 * @brief Triggered when another actor overlaps the enemy's aggro detection sphere.
-	 * 
-	 * If the overlapping actor is a player character, sets the blackboard "Target" key
-	 * in the AI controller to start engaging the character.
-	 * 
-	 * @param OverlappedComponent The component on the enemy that was overlapped (AgroSphere).
-	 * @param OtherActor The actor that entered the overlap area.
-	 * @param OtherComp The specific component of the other actor involved in the overlap.
-	 * @param OtherBodyIndex Index of the other body (if multiple).
-	 * @param bFromSweep Whether the overlap was from a sweep movement.
-	 * @param SweepResult Information about the sweep hit (if applicable).
-	 * 
-	 * @see UBlackboardComponent::SetValueAsObject()
-	 */
-	UFUNCTION()
-	void AgroSphereOverlap(UPrimitiveComponent* OverlappedComponent, AActor* OtherActor,
-		UPrimitiveComponent* OtherComp, int32 OtherBodyIndex, bool bFromSweep, const FHitResult& SweepResult);
-
 	/**
 	 * @brief Set the Blackboard key Stunned to parameter value
 	 * 
@@ -153,127 +164,86 @@ protected:
 	UFUNCTION(BlueprintCallable)
 	void SetStunned(bool Stunned);
 
-	/**
-	 * @brief Triggered when another actor overlaps the enemy's combat detection sphere.
-	 * 
-	 * If the overlapping actor is a player character, sets the blackboard "InAttackRange" key
-	 * in the AI controller to start attacking the character.
-	 * 
-	 * @param OverlappedComponent The component on the enemy that was overlapped (AgroSphere).
-	 * @param OtherActor The actor that entered the overlap area.
-	 * @param OtherComp The specific component of the other actor involved in the overlap.
-	 * @param OtherBodyIndex Index of the other body (if multiple).
-	 * @param bFromSweep Whether the overlap was from a sweep movement.
-	 * @param SweepResult Information about the sweep hit (if applicable).
-	 * 
-	 * @see UBlackboardComponent::SetValueAsObject()
-	 */
-	UFUNCTION()
-	void CombatSphereOverlap(UPrimitiveComponent* OverlappedComponent, AActor* OtherActor,
-		UPrimitiveComponent* OtherComp, int32 OtherBodyIndex, bool bFromSweep, const FHitResult& SweepResult); 
-
-	/**
-	 * @brief Triggered when another actor overlaps the enemy's combat detection sphere.
-	 * 
-	 * If the overlapping actor is a player character, sets the blackboard "InAttackRange" key
-	 * in the AI controller to stop attacking the character because he is out of range.
-	 * 
-	 * @param OverlappedComponent The component on the enemy that was overlapped (AgroSphere).
-	 * @param OtherActor The actor that entered the overlap area.
-	 * @param OtherComp The specific component of the other actor involved in the overlap.
-	 * @param OtherBodyIndex Index of the other body (if multiple).
-	 * 
-	 * @see UBlackboardComponent::SetValueAsObject()
-	 */	
-	UFUNCTION()
-	void CombatSphereEndOverlap(UPrimitiveComponent* OverlappedComponent, AActor* OtherActor,
-		UPrimitiveComponent* OtherComp, int32 OtherBodyIndex);
-
 	/**
 	 * @brief Plays the AttackMontage, jumps to Section and disables attacking for AttackWaitTime amount.
 	 * 
+	 * Starts the cooldown of the attack with that section. Does nothing if Section is NAME_None, so the enemy can try
+	 * again once an attack is available.
+	 * 
 	 * @param Section section name to jump to
 	 * @param PlayRate montage play rate
+	 * 
+	 * @see StartAttackCooldown()
 	 */
 	UFUNCTION(BlueprintCallable)
 	void PlayAttackMontage(FName Section, float PlayRate = 1.0f);
 
 	/**
-	 * @brief Based on the Enemy Type it will choose random section name for the AttackMontage
+	 * @brief Chooses an AttackMontage section from the archetype of the enemy by weight, range and cooldown
+	 * 
+	 * Does not change the attack stream or cooldowns, it returns the same section until the attack is used by
+	 * PlayAttackMontage or StartAttackCooldown. The pick is remembered so StartAttackCooldown can commit it.
 	 * 
+	 * @return FName Section of the chosen attack, or NAME_None if no attack is available
 	 */
 	UFUNCTION(BlueprintPure)
-	FName GetAttackSectionName();
+	FName GetAttackSectionName() const;
 
 	/**
-	 * @brief Called when the enemy's left weapon collider overlaps with another actor.
+	 * @brief Starts the cooldown of the attack with Section and moves the attack stream on to the next pick
 	 * 
-	 * If the overlapped actor is the player character, calculates the hit direction,
-	 * applies damage, spawns blood effects, and potentially stuns the character
-	 * based on the attack and impact direction.
+	 * If Section is the last pick of GetAttackSectionName, the picked attack gets the cooldown and the stream continues
+	 * from where that pick left it, so every draw of a pick is used once. Any other section starts the cooldown of the
+	 * first attack with that section and leaves the stream as it is.
 	 * 
-	 * @param OverlappedComponent The enemy's weapon collision component that registered the overlap.
-	 * @param OtherActor The actor overlapped by the weapon (typically the player).
-	 * @param OtherComp The specific component of the other actor involved in the overlap.
-	 * @param OtherBodyIndex Index for the overlapping body (usually unused).
-	 * @param bFromSweep Whether the overlap was due to a sweep movement.
-	 * @param SweepResult Information about the sweep hit (if applicable).
+	 * Called by PlayAttackMontage. Only graphs that use an attack without PlayAttackMontage have to call it.
 	 * 
-	 * @see DoDamage()
-	 * @see GetCharacterDirection()
-	 * @see SpawnBlood()
-	 * @see StunCharacter()
+	 * @param Section Section returned by GetAttackSectionName
 	 */
-	UFUNCTION()
-	void OnLeftWeaponOverlap(UPrimitiveComponent* OverlappedComponent, AActor* OtherActor,
-		UPrimitiveComponent* OtherComp, int32 OtherBodyIndex, bool bFromSweep, const FHitResult& SweepResult);
-		
+	UFUNCTION(BlueprintCallable)
+	void StartAttackCooldown(FName Section);
+
 	/**
-	 * @brief Called when the enemy's right weapon collider overlaps with another actor.
+	 * @brief Called by MeleeTrace when a weapon socket hits an actor, at most once per actor per swing.
 	 * 
-	 * If the overlapped actor is the player character, calculates the hit direction,
+	 * If the hit actor is the player character, calculates the hit direction,
 	 * applies damage, spawns blood effects, and potentially stuns the character
 	 * based on the attack and impact direction.
 	 * 
-	 * @param OverlappedComponent The enemy's weapon collision component that registered the overlap.
-	 * @param OtherActor The actor overlapped by the weapon (typically the player).
-	 * @param OtherComp The specific component of the other actor involved in the overlap.
-	 * @param OtherBodyIndex Index for the overlapping body (usually unused).
-	 * @param bFromSweep Whether the overlap was due to a sweep movement.
-	 * @param SweepResult Information about the sweep hit (if applicable).
+	 * @param Victim The actor hit by the weapon (typically the player).
+	 * @param SocketName Weapon socket that hit, LeftWeaponSocket or RightWeaponSocket.
+	 * @param Hit Information about the sweep hit.
 	 * 
 	 * @see DoDamage()
 	 * @see GetCharacterDirection()
 	 * @see SpawnBlood()
 	 * @see StunCharacter()
 	 */
-	UFUNCTION()
-	void OnRightWeaponOverlap(UPrimitiveComponent* OverlappedComponent, AActor* OtherActor,
-		UPrimitiveComponent* OtherComp, int32 OtherBodyIndex, bool bFromSweep, const FHitResult& SweepResult);
+	void OnWeaponHit(AActor* Victim, FName SocketName, const FHitResult& Hit);
 
 	/**
-	 * @brief Enables collision on the LeftWeaponCollision 
+	 * @brief Starts tracing the swing of LeftWeaponSocket
 	 * 
 	 */
 	UFUNCTION(BlueprintCallable)
 	void ActivateLeftWeapon();
 
 	/**
-	 * @brief Disables collision on LeftWeaponCollision 
+	 * @brief Stops tracing the swing of LeftWeaponSocket
 	 * 
 	 */
 	UFUNCTION(BlueprintCallable)
 	void DeactivateLeftWeapon();
 	
 	/**
-	 * @brief Enables collision on the RightWeaponCollision 
+	 * @brief Starts tracing the swing of RightWeaponSocket
 	 * 
 	 */
 	UFUNCTION(BlueprintCallable)
 	void ActivateRightWeapon();
 
 	/**
-	 * @brief Disables collision on the RightWeaponCollision 
+	 * @brief Stops tracing the swing of RightWeaponSocket
 	 * 
 	 */
 	UFUNCTION(BlueprintCallable)
@@ -282,9 +252,12 @@ protected:
 	/**
 	 * @brief Applys damage to Victim aka ShooterCharacter and plays Mele Impact Sound
 	 * 
+	 * The damage goes through UDamagePipelineSubsystem and StunCharacter runs once it is applied.
+	 * 
 	 * @param Victim 
+	 * @param StunDirection direction passed to StunCharacter
 	 */
-	void DoDamage(AShooterCharacter* Victim);
+	void DoDamage(AShooterCharacter* Victim, EHitDirection StunDirection);
 
 	/**
 	 * @brief Based on the HitDirection and based on which weapon overlapped spawns Blood Particles at Victim's correct location
@@ -325,7 +298,9 @@ protected:
 	void ResetCanAttack();
 
 	/**
-	 * @brief Destroys this character
+	 * @brief Hands this character back to UEnemyPoolSubsystem, or destroys it if there is no pool
+	 * 
+	 * The pool only keeps enemies of classes that were spawned through it or prewarmed, others are destroyed as before.
 	 * 
 	 */
 	UFUNCTION(BlueprintCallable)
@@ -374,7 +349,24 @@ private:
 	
 	//! Name of the Head bone
 	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = Combat, meta = (AllowPrivateAccess = "true"))
-	FString HeadBone;
+	FName HeadBone;
+
+	//! Bones where the arms and legs start, they and all bones under them are in the Limb hit zone
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = Combat, meta = (AllowPrivateAccess = "true"))
+	TArray<FName> LimbBones;
+
+	//! Damage multipliers for each hit zone
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = Combat, meta = (AllowPrivateAccess = "true"))
+	float HeadZoneMultiplier;
+
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = Combat, meta = (AllowPrivateAccess = "true"))
+	float TorsoZoneMultiplier;
+
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = Combat, meta = (AllowPrivateAccess = "true"))
+	float LimbZoneMultiplier;
+
+	//! Hit zone of each bone indexed by bone index, shared by every enemy with the same mesh through USocketCacheSubsystem
+	TSharedPtr<const TArray<EHitZone>> BoneHitZones;
 	
 	//! Time to display health bar once shot
 	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = Combat, meta = (AllowPrivateAccess = "true"))
@@ -399,6 +391,9 @@ private:
 	//! Map to store HitNumber widgets and their loocations
 	UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Category = Combat, meta = (AllowPrivateAccess = "true"))
 	TMap<UUserWidget*, FVector> HitNumbers;
+
+	//! True if the Blueprint class implements Event Tick, Tick then stays enabled
+	bool bBlueprintTick;
 	
 	//! Time before a HitNumber is removed from the screen
 	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = Combat, meta = (AllowPrivateAccess = "true"))
@@ -417,9 +412,9 @@ private:
 	
 	class AEnemyController* EnemyController;
 	
-	//! Overlap sphere for when the enemy becomes hostile
+	//! Distance at which the enemy becomes hostile to a player
 	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = Combat, meta = (AllowPrivateAccess = "true"))
-	class USphereComponent* AgroSphere;
+	float AgroRadius;
 	
 	//! True when playing get hit animation
 	UPROPERTY(VisibleAnywhere, BlueprintReadWrite, Category = Combat, meta = (AllowPrivateAccess = "true"))
@@ -433,9 +428,9 @@ private:
 	UPROPERTY(VisibleAnywhere, BlueprintReadWrite, Category = Combat, meta = (AllowPrivateAccess = "true"))
 	bool bInAttackRange;
 	
-	//! Sphere for attack range
+	//! Distance at which the enemy starts attacking a player
 	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = Combat, meta = (AllowPrivateAccess = "true"))
-	USphereComponent* CombatRangeSphere;
+	float CombatRangeRadius;
 	
 	//! Montage containing different attacks
 	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = Combat, meta = (AllowPrivateAccess = "true"))
@@ -451,13 +446,9 @@ private:
 	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = Combat, meta = (AllowPrivateAccess = "true"))
 	FName AttackC;
 	
-	//! Collision Volume for the left weapon
-	UPROPERTY(VisibleAnywhere, BlueprintReadWrite, Category = Combat, meta = (AllowPrivateAccess = "true"))
-	class UBoxComponent* LeftWeaponCollision;
-	
-	//! Collision Volume for the right weapon
-	UPROPERTY(VisibleAnywhere, BlueprintReadWrite, Category = Combat, meta = (AllowPrivateAccess = "true"))
-	UBoxComponent* RightWeaponCollision;
+	//! Sweeps the weapon sockets while a swing is active
+	UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Category = Combat, meta = (AllowPrivateAccess = "true"))
+	class UMeleeTraceComponent* MeleeTrace;
 	
 	//! Damage amount dealt to character
 	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = Combat, meta = (AllowPrivateAccess = "true"))
@@ -488,13 +479,43 @@ private:
 	//! Direction to play DeathMontage to
 	EHitDirection DeathDirection;
 	
-	//! Which type of enemy for the purpose of knowing which montage sections to play and etc.
+	//! Name of the enemy type. Without an Archetype it selects the archetype type and default montage sections
 	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = Combat, meta = (AllowPrivateAccess = "true"))
 	FName EnemyType;
 	
 	/** Tells if last bullet hit was headshot */
 	UPROPERTY(VisibleAnywhere, BlueprintReadWrite, Category = Combat, meta = (AllowPrivateAccess = "true"))
 	bool IsLastHeadshot;
+
+	//! Attack and death sections, play rates and headshot FX of this enemy. Built from EnemyType when not set
+	UPROPERTY(EditDefaultsOnly, BlueprintReadOnly, Category = Combat, meta = (AllowPrivateAccess = "true"))
+	class UEnemyArchetype* Archetype;
+
+	//! Archetype asset, or the one built from EnemyType and the section names; shared by every enemy with the same values
+	UPROPERTY()
+	UEnemyArchetype* ResolvedArchetype;
+
+	//! Seed of AttackStream, 0 derives it from the actor name
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = Combat, meta = (AllowPrivateAccess = "true"))
+	int32 AttackSeed;
+
+	//! Random stream attacks are picked with, seeded per enemy so fights can be reproduced
+	FRandomStream AttackStream;
+
+	//! AttackStream after the last pick of GetAttackSectionName, StartAttackCooldown moves AttackStream on to it
+	mutable FRandomStream PickedAttackStream;
+
+	//! Archetype index of the attack GetAttackSectionName picked last, INDEX_NONE if none was picked
+	mutable int32 PickedAttackIndex;
+
+	//! Headshot socket of the archetype resolved on the enemy mesh
+	FCachedSocket HeadshotSocketCache;
+
+	//! Headshot socket of the archetype resolved as a bone, for meshes where it is not a socket
+	FCachedBone HeadshotBoneCache;
+
+	//! World time at which each attack of the archetype can be used again
+	TArray<float> AttackReadyTimes;
 	
 	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = Combat, meta = (AllowPrivateAccess = "true"))
 	UParticleSystem* MinionDeathParticles;
@@ -518,12 +539,22 @@ private:
 	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = Combat, meta = (AllowPrivateAccess = "true"))
 	float LootDropRate;
 
+	//! Collision settings from BeginPlay, restored when the enemy is reused from the pool
+	TEnumAsByte<ECollisionEnabled::Type> DefaultMeshCollision;
+	TEnumAsByte<ECollisionEnabled::Type> DefaultCapsuleCollision;
+	FCollisionResponseContainer DefaultCapsuleResponses;
+
+	//! Current significance tier, set by UEnemySignificanceSubsystem
+	UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Category = "Significance", meta = (AllowPrivateAccess = "true"))
+	ESignificanceTier SignificanceTier;
+
 public:	
 	//! Called every frame
 	/**
 	 * @brief Called every frame.
 	 * 
-	 * Handles per-frame updates such as updateing hit numbers.
+	 * Handles per-frame updates such as updateing hit numbers. Only enabled while HitNumbers spawned by the Blueprint
+	 * ShowHitNumber are on screen, pooled Hit Numbers are updated by AShooterPlayerController.
 	 * 
 	 * @param DeltaTime The time elapsed since the last frame.
 	 * 
@@ -587,7 +618,109 @@ public:
 	UFUNCTION(BlueprintImplementableEvent)
 	void ShowHitNumber(int32 Damage, FVector HitLocation, bool HeadShot);
 
-	FORCEINLINE FString GetHeadBone() const { return HeadBone; }
+	/**
+	 * @brief Shows the Hit Number through the pool on AShooterPlayerController
+	 * 
+	 * Falls back to the Blueprint ShowHitNumber event when the player controller has no Hit Number pool. Also sets
+	 * IsLastHeadshot, which the Blueprint event used to set.
+	 * 
+	 * @param Damage damage amount to show
+	 * @param HitLocation location at which widget should be shown
+	 * @param HeadShot determines the color of the widget (true = yellow, false = white)
+	 * 
+	 * @see AShooterPlayerController::ShowHitNumber(int32 Damage, const FVector& HitLocation, bool HeadShot)
+	 */
+	void SpawnHitNumber(int32 Damage, FVector HitLocation, bool HeadShot);
+
+	/**
+	 * @brief Gets the hit zone of the bone that was hit
+	 * 
+	 * @param BoneName Bone name from the hit result
+	 * @return EHitZone Zone of the bone, Torso if the bone is not on the mesh
+	 */
+	EHitZone GetHitZone(FName BoneName) const;
+
+	/**
+	 * @brief Gets the damage multiplier of the hit zone
+	 * 
+	 * @param Zone Hit zone
+	 * @return float Damage multiplier
+	 */
+	float GetHitZoneMultiplier(EHitZone Zone) const;
+
+	/**
+	 * @brief Throttles the work this enemy does to match its significance tier
+	 * 
+	 * Lower tiers get longer actor, mesh and movement tick intervals and only tick montages while off-screen, Dormant
+	 * enemies also pause their behavior tree. UEnemyAggroSubsystem skips combat range checks from Low and aggro checks for Dormant enemies.
+	 * Does nothing if the tier did not change.
+	 * 
+	 * @param Tier New significance tier
+	 * 
+	 * @see UEnemySignificanceSubsystem
+	 */
+	void SetSignificanceTier(ESignificanceTier Tier);
+
+	/**
+	 * @brief Checks if the enemy is fighting the player
+	 * 
+	 * @return true if the enemy has a target, is in attack range or is stunned
+	 */
+	bool IsInCombat() const;
+
+	/**
+	 * @brief Called by UEnemyAggroSubsystem when a player comes within AgroRadius.
+	 * 
+	 * Sets the blackboard "Target" key in the AI controller to start engaging the character.
+	 * 
+	 * @param Character The player character that entered aggro range.
+	 * 
+	 * @see AEnemyController::SetTarget()
+	 */
+	void AgroRangeEntered(AShooterCharacter* Character);
+
+	/**
+	 * @brief Called by UEnemyAggroSubsystem when a player comes within CombatRangeRadius.
+	 * 
+	 * Sets the blackboard "InAttackRange" key in the AI controller to start attacking the character.
+	 * 
+	 * @param Character The player character that entered combat range.
+	 * 
+	 * @see AEnemyController::SetInAttackRange()
+	 */
+	void CombatRangeEntered(AShooterCharacter* Character);
+
+	/**
+	 * @brief Called by UEnemyAggroSubsystem when no player is within CombatRangeRadius any more.
+	 * 
+	 * Clears the blackboard "InAttackRange" key in the AI controller to stop attacking the character because he is
+	 * out of range.
+	 * 
+	 * @param Character The player character that left combat range.
+	 * 
+	 * @see AEnemyController::SetInAttackRange()
+	 */
+	void CombatRangeExited(AShooterCharacter* Character);
+
+	/**
+	 * @brief Parks a dead enemy hidden and without collision so UEnemyPoolSubsystem can reuse it
+	 * 
+	 * Unregisters the enemy from the game mode and subsystems, clears timers and Hit Numbers, stops montages, movement
+	 * and the behavior tree.
+	 */
+	void DeactivateForPool();
+
+	/**
+	 * @brief Brings a parked enemy back to life at Transform
+	 * 
+	 * Restores health, combat flags, the attack stream and cooldowns, the collision changed by TakeDamage and the
+	 * blackboard values including CharacterDead, restarts the behavior tree and registers the enemy with the game mode and subsystems again.
+	 * 
+	 * @param Transform Where the enemy is spawned
+	 */
+	void ActivateFromPool(const FTransform& Transform);
+
+	FORCEINLINE FName GetHeadBone() const { return HeadBone; }
 
 	FORCEINLINE UBehaviorTree* GetBehaviorTree() const { return BehaviorTree; }
 
@@ -597,4 +730,61 @@ public:
 	FORCEINLINE float GetMaxHealth() const { return MaxHealth; }
 
 	FORCEINLINE bool IsDead() const { return bDying; }
+
+	/**
+	 * @brief Builds an archetype from EnemyType and the attack section names, for enemies without an asset
+	 * 
+	 * @param Outer Owner of the new archetype
+	 * @return UEnemyArchetype* New archetype
+	 */
+	UEnemyArchetype* CreateDefaultArchetype(UObject* Outer) const;
+
+	/**
+	 * @brief Gets the archetype of the enemy, resolving it on the first call
+	 * 
+	 * Called in BeginPlay, and earlier by the game mode when the enemy is possessed before it begins play.
+	 * 
+	 * @return UEnemyArchetype* Archetype asset, or the one built from EnemyType and the section names
+	 */
+	UEnemyArchetype* ResolveArchetype();
+
+	//! Gets the type of the archetype, live enemies are counted by it
+	EEnemyType GetArchetypeEnemyType();
+
+	FORCEINLINE FName GetEnemyType() const { return EnemyType; }
+	FORCEINLINE FName GetAttackLFast() const { return AttackLFast; }
+	FORCEINLINE FName GetAttackRFast() const { return AttackRFast; }
+	FORCEINLINE FName GetAttackCFast() const { return AttackCFast; }
+	FORCEINLINE FName GetAttackL() const { return AttackL; }
+	FORCEINLINE FName GetAttackR() const { return AttackR; }
+	FORCEINLINE FName GetAttackC() const { return AttackC; }
+	FORCEINLINE UParticleSystem* GetMinionDeathParticles() const { return MinionDeathParticles; }
+	FORCEINLINE USoundCue* GetHeadshotExplosionSound() const { return HeadshotExplosionSound; }
+
+	/**
+	 * @brief Gets where headshot death FX spawn, resolved again only when the mesh changes
+	 * 
+	 * The archetype's headshot socket is used as a socket if the mesh has one, otherwise as a bone.
+	 * 
+	 * @return FTransform Socket or bone transform, or the mesh transform if the mesh has neither
+	 */
+	FTransform GetHeadshotTransform();
+
+	/**
+	 * @brief Reseeds the stream attacks are picked with and resets attack cooldowns
+	 * 
+	 * @param Seed Seed of the stream, 0 derives it from the actor name
+	 */
+	UFUNCTION(BlueprintCallable)
+	void SeedAttackStream(int32 Seed);
+
+	FORCEINLINE UEnemyArchetype* GetArchetypeAsset() const { return Archetype; }
+
+	FORCEINLINE UEnemyArchetype* GetArchetype() const { return ResolvedArchetype; }
+
+	FORCEINLINE ESignificanceTier GetSignificanceTier() const { return SignificanceTier; }
+
+	FORCEINLINE float GetAgroRadius() const { return AgroRadius; }
+
+	FORCEINLINE float GetCombatRangeRadius() const { return CombatRangeRadius; }
 };
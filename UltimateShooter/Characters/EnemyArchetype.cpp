@@ -0,0 +1,172 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+
+#include "EnemyArchetype.h"
+#include "UltimateShooter/UltimateShooter.h"
+
+DECLARE_CYCLE_STAT(TEXT("Pick Attack"), STAT_PickAttack, STATGROUP_UltimateShooter);
+DECLARE_DWORD_COUNTER_STAT(TEXT("No Attack Available"), STAT_NoAttackAvailable, STATGROUP_UltimateShooter);
+
+UEnemyArchetype::UEnemyArchetype() :
+	EnemyType{EEnemyType::EET_Other}, MaxAttackRedraws{4}, bOverrideAttackPlayRate{false}, AttackPlayRate{1.f}, HeadshotDeathSection{NAME_None},
+	HeadshotSocket{NAME_None}, HeadshotParticles{nullptr}, HeadshotSound{nullptr}
+{
+
+}
+
+void UEnemyArchetype::PostLoad()
+{
+	Super::PostLoad();
+
+	BuildAttackTable();
+}
+
+#if WITH_EDITOR
+void UEnemyArchetype::PostEditChangeProperty(FPropertyChangedEvent& PropertyChangedEvent)
+{
+	Super::PostEditChangeProperty(PropertyChangedEvent);
+
+	BuildAttackTable();
+}
+#endif
+
+int32 UEnemyArchetype::PickAttack(FRandomStream& Stream, float Distance, float Now, const TArray<float>& ReadyTimes) const
+{
+	SCOPE_CYCLE_COUNTER(STAT_PickAttack);
+
+	const int32 NumAttacks = AttackProbabilities.Num();
+	if (NumAttacks == 0) return INDEX_NONE;
+
+	for (int32 i = 0; i < MaxAttackRedraws; i++)
+	{
+		const int32 Column = Stream.RandRange(0, NumAttacks - 1);
+		const int32 Index = Stream.GetFraction() < AttackProbabilities[Column] ? Column : AttackAliases[Column];
+
+		if (IsAttackAvailable(Index, Distance, Now, ReadyTimes))
+		{
+			return Index;
+		}
+	}
+
+	//! Most attacks are unavailable, pick by weight among the ones that are left
+	float TotalWeight{ 0.f };
+	for (int32 i = 0; i < NumAttacks; i++)
+	{
+		if (IsAttackAvailable(i, Distance, Now, ReadyTimes))
+		{
+			TotalWeight += Attacks[i].Weight;
+		}
+	}
+
+	float Roll{ Stream.GetFraction() * TotalWeight };
+	int32 LastAvailable{ INDEX_NONE };
+	for (int32 i = 0; i < NumAttacks; i++)
+	{
+		if (!IsAttackAvailable(i, Distance, Now, ReadyTimes)) continue;
+
+		LastAvailable = i;
+		Roll -= Attacks[i].Weight;
+		if (Roll < 0.f)
+		{
+			return i;
+		}
+	}
+
+	INC_DWORD_STAT(STAT_NoAttackAvailable);
+	return LastAvailable;
+}
+
+void UEnemyArchetype::BuildAttackTable()
+{
+	const int32 NumAttacks = Attacks.Num();
+	AttackProbabilities.Init(1.f, NumAttacks);
+	AttackAliases.Init(0, NumAttacks);
+	if (NumAttacks == 0) return;
+
+	float TotalWeight{ 0.f };
+	for (const FEnemyAttack& Attack : Attacks)
+	{
+		TotalWeight += FMath::Max(Attack.Weight, 0.f);
+	}
+
+	//! Weights scaled so their average is 1, all zero weights are treated as equal
+	TArray<float> Scaled;
+	Scaled.SetNumUninitialized(NumAttacks);
+	for (int32 i = 0; i < NumAttacks; i++)
+	{
+		Scaled[i] = TotalWeight > 0.f ? FMath::Max(Attacks[i].Weight, 0.f) * NumAttacks / TotalWeight : 1.f;
+	}
+
+	TArray<int32> Small;
+	TArray<int32> Large;
+	for (int32 i = 0; i < NumAttacks; i++)
+	{
+		(Scaled[i] < 1.f ? Small : Large).Add(i);
+	}
+
+	while (Small.Num() > 0 && Large.Num() > 0)
+	{
+		const int32 Less = Small.Pop();
+		const int32 More = Large.Pop();
+
+		AttackProbabilities[Less] = Scaled[Less];
+		AttackAliases[Less] = More;
+
+		Scaled[More] = (Scaled[More] + Scaled[Less]) - 1.f;
+		(Scaled[More] < 1.f ? Small : Large).Add(More);
+	}
+
+	//! Whatever is left is 1 up to rounding errors
+	for (int32 Index : Large)
+	{
+		AttackProbabilities[Index] = 1.f;
+		AttackAliases[Index] = Index;
+	}
+	for (int32 Index : Small)
+	{
+		AttackProbabilities[Index] = 1.f;
+		AttackAliases[Index] = Index;
+	}
+}
+
+FName UEnemyArchetype::GetDeathSection(bool bFromFront, bool bHeadshot) const
+{
+	if (bHeadshot && HasHeadshotDeath())
+	{
+		return HeadshotDeathSection;
+	}
+
+	return GetRandomSection(bFromFront ? DeathFrontSections : DeathBackSections);
+}
+
+float UEnemyArchetype::GetAttackPlayRate(float RequestedPlayRate) const
+{
+	return bOverrideAttackPlayRate ? AttackPlayRate : RequestedPlayRate;
+}
+
+bool UEnemyArchetype::HasDirectionalDeath() const
+{
+	return DeathFrontSections.Num() > 0 || DeathBackSections.Num() > 0;
+}
+
+bool UEnemyArchetype::HasHeadshotDeath() const
+{
+	return !HeadshotDeathSection.IsNone();
+}
+
+bool UEnemyArchetype::IsAttackAvailable(int32 Index, float Distance, float Now, const TArray<float>& ReadyTimes) const
+{
+	const FEnemyAttack& Attack = Attacks[Index];
+	if (ReadyTimes.IsValidIndex(Index) && Now < ReadyTimes[Index]) return false;
+	if (Distance < Attack.MinRange) return false;
+	if (Attack.MaxRange > 0.f && Distance > Attack.MaxRange) return false;
+
+	return true;
+}
+
+FName UEnemyArchetype::GetRandomSection(const TArray<FName>& Sections)
+{
+	if (Sections.Num() == 0) return NAME_None;
+
+	return Sections[FMath::RandRange(0, Sections.Num() - 1)];
+}
@@ -0,0 +1,179 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Engine/DataAsset.h"
+#include "UltimateShooter/Enums/EnemyType.h"
+#include "EnemyArchetype.generated.h"
+
+USTRUCT(BlueprintType)
+struct FEnemyAttack
+{
+	GENERATED_BODY()
+
+	//! AttackMontage section of the attack
+	UPROPERTY(EditAnywhere, BlueprintReadWrite)
+	FName Section;
+
+	//! Relative chance of the attack being picked
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, meta = (ClampMin = "0.0"))
+	float Weight = 1.f;
+
+	//! Seconds before the same enemy can use the attack again
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, meta = (ClampMin = "0.0"))
+	float Cooldown = 0.f;
+
+	//! Closest distance to the target the attack is used at
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, meta = (ClampMin = "0.0"))
+	float MinRange = 0.f;
+
+	//! Furthest distance to the target the attack is used at, 0 for no limit
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, meta = (ClampMin = "0.0"))
+	float MaxRange = 0.f;
+};
+
+/**
+ * @brief Data asset describing how an enemy type attacks and dies.
+ * 
+ * AEnemy picks attack and death montage sections from the tables here by index, so a new enemy type only needs a new
+ * asset. Enemies without an asset get one built from their EnemyType and section names by UEnemyArchetypeSubsystem.
+ */
+UCLASS(BlueprintType)
+class ULTIMATESHOOTER_API UEnemyArchetype : public UPrimaryDataAsset
+{
+	GENERATED_BODY()
+
+public:
+	/**
+	 * @brief Construct a new UEnemyArchetype object with no sections
+	 * 
+	 */
+	UEnemyArchetype();
+
+	//! Builds the attack alias table of an archetype loaded from disk
+	virtual void PostLoad() override;
+
+#if WITH_EDITOR
+	//! Rebuilds the attack alias table when Attacks is edited
+	virtual void PostEditChangeProperty(FPropertyChangedEvent& PropertyChangedEvent) override;
+#endif
+
+	/**
+	 * @brief Picks an attack by weight from the alias table in constant time
+	 * 
+	 * An attack that is cooling down or out of range for Distance is redrawn a few times, after that the available
+	 * attacks are searched in order.
+	 * 
+	 * @param Stream Random stream of the attacking enemy, so its choices can be reproduced
+	 * @param Distance Distance to the target
+	 * @param Now Current world time
+	 * @param ReadyTimes World time at which each attack is ready again, indexed like Attacks
+	 * @return int32 Index of the attack, or INDEX_NONE if no attack is available
+	 */
+	int32 PickAttack(FRandomStream& Stream, float Distance, float Now, const TArray<float>& ReadyTimes) const;
+
+	/**
+	 * @brief Builds AttackProbabilities and AttackAliases from the weights of Attacks with Vose's alias method
+	 * 
+	 */
+	void BuildAttackTable();
+
+	/**
+	 * @brief Picks the DeathMontage section for the hit
+	 * 
+	 * @param bFromFront true when the killer is in front of the enemy
+	 * @param bHeadshot true when the killing bullet was a headshot
+	 * @return FName Section name, or NAME_None to play the montage from the start
+	 */
+	FName GetDeathSection(bool bFromFront, bool bHeadshot) const;
+
+	/**
+	 * @brief Gets the rate AttackMontage is played at
+	 * 
+	 * @param RequestedPlayRate Play rate passed to AEnemy::PlayAttackMontage
+	 * @return float AttackPlayRate when it overrides the requested rate, RequestedPlayRate otherwise
+	 */
+	float GetAttackPlayRate(float RequestedPlayRate) const;
+
+	/**
+	 * @brief Checks if the death animation depends on the direction of the killer
+	 * 
+	 */
+	bool HasDirectionalDeath() const;
+
+	/**
+	 * @brief Checks if a headshot kill plays HeadshotDeathSection with its particles and sound
+	 * 
+	 */
+	bool HasHeadshotDeath() const;
+
+private:
+	//! Picks a random entry of Sections, NAME_None if it is empty
+	static FName GetRandomSection(const TArray<FName>& Sections);
+
+	//! Checks if the attack at Index is off cooldown and in range
+	bool IsAttackAvailable(int32 Index, float Distance, float Now, const TArray<float>& ReadyTimes) const;
+
+	//! Type of the enemy
+	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "Type", meta = (AllowPrivateAccess = "true"))
+	EEnemyType EnemyType;
+
+	//! Attacks of the enemy, one is picked by weight for every attack
+	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "Attack", meta = (AllowPrivateAccess = "true"))
+	TArray<FEnemyAttack> Attacks;
+
+	//! Chance of keeping the drawn attack instead of its alias, indexed like Attacks
+	TArray<float> AttackProbabilities;
+
+	//! Attack used when the drawn one is not kept, indexed like Attacks
+	TArray<int32> AttackAliases;
+
+	//! Times a drawn attack that is not available is redrawn before searching in order
+	int32 MaxAttackRedraws;
+
+	//! true when AttackPlayRate is used instead of the play rate passed to AEnemy::PlayAttackMontage
+	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "Attack", meta = (AllowPrivateAccess = "true"))
+	bool bOverrideAttackPlayRate;
+
+	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "Attack", meta = (AllowPrivateAccess = "true", EditCondition = "bOverrideAttackPlayRate"))
+	float AttackPlayRate;
+
+	//! DeathMontage sections played when the killer is in front of the enemy. Empty plays the montage from the start
+	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "Death", meta = (AllowPrivateAccess = "true"))
+	TArray<FName> DeathFrontSections;
+
+	//! DeathMontage sections played when the killer is behind the enemy. Empty plays the montage from the start
+	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "Death", meta = (AllowPrivateAccess = "true"))
+	TArray<FName> DeathBackSections;
+
+	//! DeathMontage section played on a headshot kill, None when headshots die like any other hit
+	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "Death", meta = (AllowPrivateAccess = "true"))
+	FName HeadshotDeathSection;
+
+	//! Socket the headshot particles and sound are spawned at
+	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "Death", meta = (AllowPrivateAccess = "true"))
+	FName HeadshotSocket;
+
+	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "Death", meta = (AllowPrivateAccess = "true"))
+	class UParticleSystem* HeadshotParticles;
+
+	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "Death", meta = (AllowPrivateAccess = "true"))
+	class USoundCue* HeadshotSound;
+
+	//! AEnemy fills the archetype of enemies that have no asset
+	friend class AEnemy;
+
+public:
+	FORCEINLINE EEnemyType GetEnemyType() const { return EnemyType; }
+
+	FORCEINLINE int32 GetNumAttacks() const { return Attacks.Num(); }
+
+	FORCEINLINE const FEnemyAttack* GetAttack(int32 Index) const { return Attacks.IsValidIndex(Index) ? &Attacks[Index] : nullptr; }
+
+	FORCEINLINE FName GetHeadshotSocket() const { return HeadshotSocket; }
+
+	FORCEINLINE UParticleSystem* GetHeadshotParticles() const { return HeadshotParticles; }
+
+	FORCEINLINE USoundCue* GetHeadshotSound() const { return HeadshotSound; }
+};
@@ -5,8 +5,23 @@
 #include "BehaviorTree/BehaviorTreeComponent.h"
 #include "Enemy.h"
 #include "BehaviorTree/BehaviorTree.h"
+#include "BehaviorTree/Blackboard/BlackboardKeyType_Bool.h"
+#include "BehaviorTree/Blackboard/BlackboardKeyType_Object.h"
+#include "BehaviorTree/Blackboard/BlackboardKeyType_Vector.h"
+#include "UltimateShooter/GameModes/UltimateShooterGameModeBase.h"
+#include "UltimateShooter/UltimateShooter.h"
 
-AEnemyController::AEnemyController()
+DECLARE_DWORD_ACCUMULATOR_STAT(TEXT("Blackboard Writes Skipped"), STAT_BlackboardWritesSkipped, STATGROUP_UltimateShooter);
+
+AEnemyController::AEnemyController() :
+    TargetKey{FBlackboard::InvalidKey},
+    CanAttackKey{FBlackboard::InvalidKey},
+    InAttackRangeKey{FBlackboard::InvalidKey},
+    StunnedKey{FBlackboard::InvalidKey},
+    DeadKey{FBlackboard::InvalidKey},
+    CharacterDeadKey{FBlackboard::InvalidKey},
+    PatrolPointKey{FBlackboard::InvalidKey},
+    PatrolPoint2Key{FBlackboard::InvalidKey}
 {
     BlackboardComponent = CreateDefaultSubobject<UBlackboardComponent>(TEXT("BlackboardComponent"));
     check(BlackboardComponent);
@@ -27,8 +42,27 @@ void AEnemyController::OnPossess(APawn* InPawn)
         if (Enemy->GetBehaviorTree())
         {
             BlackboardComponent->InitializeBlackboard(*(Enemy->GetBehaviorTree()->BlackboardAsset));
+            CacheBlackboardKeys();
         }
+
+        AUltimateShooterGameModeBase* GameMode = GetWorld()->GetAuthGameMode<AUltimateShooterGameModeBase>();
+        if (GameMode)
+        {
+            GameMode->RegisterEnemy(Enemy);
+        }
+    }
+}
+
+void AEnemyController::OnUnPossess()
+{
+    AEnemy* Enemy = Cast<AEnemy>(GetPawn());
+    AUltimateShooterGameModeBase* GameMode = GetWorld()->GetAuthGameMode<AUltimateShooterGameModeBase>();
+    if (Enemy && GameMode)
+    {
+        GameMode->UnregisterEnemy(Enemy);
     }
+
+    Super::OnUnPossess();
 }
 
 bool AEnemyController::IsDead()
@@ -40,4 +74,112 @@ bool AEnemyController::IsDead()
     }
 
     return true;
-}
\ No newline at end of file
+}
+
+void AEnemyController::CacheBlackboardKeys()
+{
+    TargetKey = BlackboardComponent->GetKeyID(FName("Target"));
+    CanAttackKey = BlackboardComponent->GetKeyID(FName("CanAttack"));
+    InAttackRangeKey = BlackboardComponent->GetKeyID(FName("InAttackRange"));
+    StunnedKey = BlackboardComponent->GetKeyID(FName("Stunned"));
+    DeadKey = BlackboardComponent->GetKeyID(FName("Dead"));
+    CharacterDeadKey = BlackboardComponent->GetKeyID(FName("CharacterDead"));
+    PatrolPointKey = BlackboardComponent->GetKeyID(FName("PatrolPoint"));
+    PatrolPoint2Key = BlackboardComponent->GetKeyID(FName("PatrolPoint2"));
+}
+
+void AEnemyController::SetAIDormant(bool bDormant)
+{
+    if (BrainComponent == nullptr || BrainComponent->IsPaused() == bDormant) return;
+
+    if (bDormant)
+    {
+        BrainComponent->PauseLogic(TEXT("Dormant"));
+    }
+    else
+    {
+        BrainComponent->ResumeLogic(TEXT("Dormant"));
+    }
+}
+
+UObject* AEnemyController::GetTarget() const
+{
+    if (TargetKey == FBlackboard::InvalidKey) return nullptr;
+
+    return BlackboardComponent->GetValue<UBlackboardKeyType_Object>(TargetKey);
+}
+
+void AEnemyController::SetTarget(UObject* Target)
+{
+    SetObjectKey(TargetKey, Target);
+}
+
+void AEnemyController::SetCanAttack(bool bCanAttack)
+{
+    SetBoolKey(CanAttackKey, bCanAttack);
+}
+
+void AEnemyController::SetInAttackRange(bool bInAttackRange)
+{
+    SetBoolKey(InAttackRangeKey, bInAttackRange);
+}
+
+void AEnemyController::SetStunned(bool bStunned)
+{
+    SetBoolKey(StunnedKey, bStunned);
+}
+
+void AEnemyController::SetDead(bool bDead)
+{
+    SetBoolKey(DeadKey, bDead);
+}
+
+void AEnemyController::SetCharacterDead(bool bCharacterDead)
+{
+    SetBoolKey(CharacterDeadKey, bCharacterDead);
+}
+
+void AEnemyController::SetPatrolPoints(const FVector& WorldPatrolPoint, const FVector& WorldPatrolPoint2)
+{
+    SetVectorKey(PatrolPointKey, WorldPatrolPoint);
+    SetVectorKey(PatrolPoint2Key, WorldPatrolPoint2);
+}
+
+void AEnemyController::SetBoolKey(FBlackboard::FKey Key, bool bValue)
+{
+    if (Key == FBlackboard::InvalidKey) return;
+
+    if (BlackboardComponent->GetValue<UBlackboardKeyType_Bool>(Key) == bValue)
+    {
+        INC_DWORD_STAT(STAT_BlackboardWritesSkipped);
+        return;
+    }
+
+    BlackboardComponent->SetValue<UBlackboardKeyType_Bool>(Key, bValue);
+}
+
+void AEnemyController::SetObjectKey(FBlackboard::FKey Key, UObject* Value)
+{
+    if (Key == FBlackboard::InvalidKey) return;
+
+    if (BlackboardComponent->GetValue<UBlackboardKeyType_Object>(Key) == Value)
+    {
+        INC_DWORD_STAT(STAT_BlackboardWritesSkipped);
+        return;
+    }
+
+    BlackboardComponent->SetValue<UBlackboardKeyType_Object>(Key, Value);
+}
+
+void AEnemyController::SetVectorKey(FBlackboard::FKey Key, const FVector& Value)
+{
+    if (Key == FBlackboard::InvalidKey) return;
+
+    if (BlackboardComponent->GetValue<UBlackboardKeyType_Vector>(Key).Equals(Value))
+    {
+        INC_DWORD_STAT(STAT_BlackboardWritesSkipped);
+        return;
+    }
+
+    BlackboardComponent->SetValue<UBlackboardKeyType_Vector>(Key, Value);
+}
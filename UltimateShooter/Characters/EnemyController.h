@@ -4,6 +4,7 @@
 
 #include "CoreMinimal.h"
 #include "AIController.h"
+#include "BehaviorTree/BehaviorTreeTypes.h"
 #include "EnemyController.generated.h"
 
 /**
@@ -25,8 +26,9 @@ public:
 	/**
 	 * @brief Called when the AI controller takes control of a pawn.
 	 * 
-	 * Casts the possessed pawn to an AEnemy and initializes the blackboard
-	 * using the enemy's assigned behavior tree, if available.
+	 * Casts the possessed pawn to an AEnemy, initializes the blackboard
+	 * using the enemy's assigned behavior tree, if available, and registers
+	 * the enemy with the game mode.
 	 * 
 	 * @param InPawn The pawn that was just possessed by this controller.
 	 * 
@@ -36,7 +38,74 @@ public:
 	 */
 	virtual void OnPossess(APawn* InPawn) override;
 
+	/**
+	 * @brief Called when the AI controller releases its pawn.
+	 * 
+	 * Removes the enemy from the game mode's live-enemy registry in case it
+	 * leaves play without dying.
+	 * 
+	 * @see AAIController::OnUnPossess()
+	 */
+	virtual void OnUnPossess() override;
+
+	/**
+	 * @brief Pauses or resumes the behavior tree
+	 * 
+	 * The behavior tree schedules its own tick interval after every tick, so a component tick interval set from outside 
+	 * does not hold. Paused logic stops ticking, running tasks and services until it is resumed.
+	 * 
+	 * @param bDormant true pauses the logic, false resumes it
+	 */
+	void SetAIDormant(bool bDormant);
+
+	//! Reads the Target key
+	UObject* GetTarget() const;
+
+	//! Writes the Target key, skipped if the value is unchanged
+	void SetTarget(UObject* Target);
+
+	//! Writes the CanAttack key, skipped if the value is unchanged
+	void SetCanAttack(bool bCanAttack);
+
+	//! Writes the InAttackRange key, skipped if the value is unchanged
+	void SetInAttackRange(bool bInAttackRange);
+
+	//! Writes the Stunned key, skipped if the value is unchanged
+	void SetStunned(bool bStunned);
+
+	//! Writes the Dead key, skipped if the value is unchanged
+	void SetDead(bool bDead);
+
+	//! Writes the CharacterDead key, skipped if the value is unchanged
+	void SetCharacterDead(bool bCharacterDead);
+
+	/**
+	 * @brief Writes both patrol point keys, each skipped if unchanged
+	 * 
+	 * @param WorldPatrolPoint First patrol point in world space
+	 * @param WorldPatrolPoint2 Second patrol point in world space
+	 */
+	void SetPatrolPoints(const FVector& WorldPatrolPoint, const FVector& WorldPatrolPoint2);
+
 private:
+	/**
+	 * @brief Resolves every blackboard key name to its ID
+	 * 
+	 * Called once after the blackboard is initialized so the setters never
+	 * have to look keys up by name. Keys missing from the asset resolve to
+	 * FBlackboard::InvalidKey and their setters become no-ops.
+	 */
+	void CacheBlackboardKeys();
+
+	//! Sets a bool key if it is valid and the value differs
+	void SetBoolKey(FBlackboard::FKey Key, bool bValue);
+
+	//! Sets an object key if it is valid and the value differs
+	void SetObjectKey(FBlackboard::FKey Key, UObject* Value);
+
+	//! Sets a vector key if it is valid and the value differs
+	void SetVectorKey(FBlackboard::FKey Key, const FVector& Value);
+
 	//! Blackboard component for this enemy
 	UPROPERTY(BlueprintReadWrite, Category = "AI Behavior", meta = (AllowPrivateAccess = "true"))
 	class UBlackboardComponent* BlackboardComponent;
@@ -45,6 +114,16 @@ private:
 	UPROPERTY(BlueprintReadWrite, Category = "AI Behavior", meta = (AllowPrivateAccess = "true"))
 	class UBehaviorTreeComponent* BehaviorTreeComponent;
 
+	//! Blackboard key IDs resolved in OnPossess
+	FBlackboard::FKey TargetKey;
+	FBlackboard::FKey CanAttackKey;
+	FBlackboard::FKey InAttackRangeKey;
+	FBlackboard::FKey StunnedKey;
+	FBlackboard::FKey DeadKey;
+	FBlackboard::FKey CharacterDeadKey;
+	FBlackboard::FKey PatrolPointKey;
+	FBlackboard::FKey PatrolPoint2Key;
+
 public:
 	FORCEINLINE UBlackboardComponent* GetBlackboardComponent() const { return BlackboardComponent; }
 
@@ -24,6 +24,22 @@
 #include "Enemy.h"
 #include "EnemyController.h"
 #include "UltimateShooter/GameModes/UltimateShooterGameModeBase.h"
+#include "UltimateShooter/Subsystems/LootPoolSubsystem.h"
+#include "UltimateShooter/Subsystems/FXBudgetSubsystem.h"
+#include "UltimateShooter/Subsystems/SoundDispatchSubsystem.h"
+#include "UltimateShooter/Subsystems/DamagePipelineSubsystem.h"
+#include "UltimateShooter/Subsystems/ItemDataSubsystem.h"
+
+DECLARE_DWORD_COUNTER_STAT(TEXT("Hitscan Traces"), STAT_HitscanTraces, STATGROUP_UltimateShooter);
+DECLARE_DWORD_COUNTER_STAT(TEXT("Hitscan Shots Resolved"), STAT_HitscanShotsResolved, STATGROUP_UltimateShooter);
+DECLARE_DWORD_COUNTER_STAT(TEXT("Hitscan Shots Dropped"), STAT_HitscanShotsDropped, STATGROUP_UltimateShooter);
+DECLARE_DWORD_COUNTER_STAT(TEXT("Hitscan Shots Pending"), STAT_HitscanShotsPending, STATGROUP_UltimateShooter);
+DECLARE_FLOAT_COUNTER_STAT(TEXT("Hitscan Latency (ms)"), STAT_HitscanLatency, STATGROUP_UltimateShooter);
+DECLARE_DWORD_COUNTER_STAT(TEXT("Aim Ray Traces"), STAT_AimRayTraces, STATGROUP_UltimateShooter);
+DECLARE_DWORD_COUNTER_STAT(TEXT("Aim Ray Traces Saved"), STAT_AimRayTracesSaved, STATGROUP_UltimateShooter);
+DECLARE_DWORD_COUNTER_STAT(TEXT("Item Focus Candidates"), STAT_ItemFocusCandidates, STATGROUP_UltimateShooter);
+DECLARE_DWORD_COUNTER_STAT(TEXT("Item Focus Occlusion Traces"), STAT_ItemFocusOcclusionTraces, STATGROUP_UltimateShooter);
+DECLARE_CYCLE_STAT(TEXT("TraceForItems"), STAT_TraceForItems, STATGROUP_UltimateShooter);
 
 // Sets default values
 AShooterCharacter::AShooterCharacter() :
@@ -42,7 +58,8 @@ AShooterCharacter::AShooterCharacter() :
 	//? Automatic fire variables
 	bFireButtonPressed{false}, bShouldFire{true},
 	//? Item trace variables
-	bShouldTraceForItems{false}, TraceHitItemLastFrame{NULL},
+	bShouldTraceForItems{false}, TraceHitItemLastFrame{NULL}, bFocusedCandidateVisible{false}, LastFocusOcclusionTime{0.f},
+	FocusConeAngle{6.f}, FocusOcclusionInterval{0.2f},
 	//? CameraInterpLocation variables
 	CameraInterpDistance{250.f}, CameraInterpElevation{65.f},
 	//? Ammo 
@@ -259,34 +276,161 @@ void AShooterCharacter::FireWeapon()
 	}
 }
 
-bool AShooterCharacter::GetBeamEndLocation(const FVector& MuzzleSocketLocation, FHitResult& OutHitResult)
+void AShooterCharacter::QueueHitscan(const FTransform& BarrelTransform)
 {
-	FVector OutBeamLocation;
+	FHitscanRequest Request;
+	Request.BarrelTransform = BarrelTransform;
+	Request.Damage = EquippedWeapon->GetDamage();
+	Request.HeadShotDamage = EquippedWeapon->GetHeadShotDamage();
+	Request.DamageModel = EquippedWeapon->GetDamageModel();
+	Request.FireTime = GetWorld()->GetTimeSeconds();
 
-	FHitResult CrosshairHitResult;
-	bool bCrosshairHit = TraceUnderCrosshair(CrosshairHitResult,OutBeamLocation);
+	if (IsAimRayCacheValid())
+	{
+		//! Crosshair was already traced this frame, go straight to the barrel trace, the shot resolves next frame
+		INC_DWORD_STAT(STAT_AimRayTracesSaved);
+		Request.CrosshairEnd = AimRayCache.HitLocation;
+		SendBarrelTrace(Request, AimRayCache.HitLocation);
+	}
+	else
+	{
+		FVector CrosshairStart;
+		FVector CrosshairEnd;
+		if (!GetCrosshairRay(CrosshairStart, CrosshairEnd)) return;
+
+		Request.CrosshairEnd = CrosshairEnd;
+
+		//! Crosshair result is ready next frame, ProcessHitscans then sends the barrel trace, so the shot resolves two frames from now
+		Request.TraceHandle = GetWorld()->AsyncLineTraceByChannel(EAsyncTraceType::Single, CrosshairStart, CrosshairEnd, ECollisionChannel::ECC_Visibility);
+		INC_DWORD_STAT(STAT_HitscanTraces);
+	}
+
+	PendingHitscans.Add(Request);
+}
+
+void AShooterCharacter::SendBarrelTrace(FHitscanRequest& Request, const FVector& BeamEnd)
+{
+	const FVector WeaponTraceStart{ Request.BarrelTransform.GetLocation() };
+	const FVector StartToEnd{ BeamEnd - WeaponTraceStart };
+	const FVector WeaponTraceEnd{ WeaponTraceStart + StartToEnd * 1.25f };
+
+	Request.TraceHandle = GetWorld()->AsyncLineTraceByChannel(EAsyncTraceType::Single, WeaponTraceStart, WeaponTraceEnd, ECollisionChannel::ECC_Visibility);
+	Request.bBarrelTraceInFlight = true;
+	INC_DWORD_STAT(STAT_HitscanTraces);
+}
+
+void AShooterCharacter::ProcessHitscans()
+{
+	if (PendingHitscans.Num() == 0) return;
 
-	if (bCrosshairHit)
+	UWorld* World = GetWorld();
+
+	for (int32 i = 0; i < PendingHitscans.Num(); i++)
 	{
-		//! Tenative beam location - still need to trace from gun 
-		OutBeamLocation = CrosshairHitResult.Location;
+		FHitscanRequest& Request = PendingHitscans[i];
+
+		FTraceDatum TraceData;
+		if (!World->QueryTraceData(Request.TraceHandle, TraceData))
+		{
+			if (!World->IsTraceHandleValid(Request.TraceHandle, false))
+			{
+				//! Trace results are only kept for one frame, this shot missed them
+				PendingHitscans.RemoveAt(i--);
+				INC_DWORD_STAT(STAT_HitscanShotsDropped);
+			}
+			//! Otherwise still in flight
+			continue;
+		}
+
+		const FHitResult* BlockingHit = TraceData.OutHits.FindByPredicate([](const FHitResult& Hit) { return Hit.bBlockingHit; });
+
+		if (!Request.bBarrelTraceInFlight)
+		{
+			//! Crosshair trace is back. Tentative beam location - still need to trace from gun
+			const FVector BeamEnd{ BlockingHit ? BlockingHit->Location : Request.CrosshairEnd };
+			Request.CrosshairEnd = BeamEnd;
+			SendBarrelTrace(Request, BeamEnd);
+			continue;
+		}
+
+		//! Barrel trace is back, nothing blocked the bullet if there is no blocking hit
+		if (BlockingHit)
+		{
+			ResolveHitscan(Request, *BlockingHit);
+		}
+
+		SET_FLOAT_STAT(STAT_HitscanLatency, (World->GetTimeSeconds() - Request.FireTime) * 1000.f);
+		INC_DWORD_STAT(STAT_HitscanShotsResolved);
+		PendingHitscans.RemoveAt(i--);
 	}
-	//! OutBeam Location is End if we didnt hit anything in TraceUnderCrosshair 
 
-	//TODO Weapon Barrel Line Trace
-	const FVector WeaponTraceStart{ MuzzleSocketLocation };
-	const FVector StartToEnd{ OutBeamLocation - MuzzleSocketLocation };
-	const FVector WeaponTraceEnd { MuzzleSocketLocation + StartToEnd * 1.25f };
+	SET_DWORD_STAT(STAT_HitscanShotsPending, PendingHitscans.Num());
+}
 
-	GetWorld()->LineTraceSingleByChannel(OutHitResult, WeaponTraceStart, WeaponTraceEnd, ECollisionChannel::ECC_Visibility);
+void AShooterCharacter::ResolveHitscan(const FHitscanRequest& Request, const FHitResult& BeamHitResult)
+{
+	if (BeamHitResult.GetActor())
+	{
+		IBulletHitInterface* HitInterface = Cast<IBulletHitInterface>(BeamHitResult.GetActor());
+		if (HitInterface)
+		{
+			HitInterface->BulletHit_Implementation(BeamHitResult, this, GetController());
+		}
 
-	if(!OutHitResult.bBlockingHit)
+		AEnemy* HitEnemy = Cast<AEnemy>(BeamHitResult.GetActor());
+		if (HitEnemy)
+		{
+			int32 Damage{};
+			bool HeadShot{};
+			const float Distance{ static_cast<float>(FVector::Dist(Request.BarrelTransform.GetLocation(), BeamHitResult.Location)) };
+			const EHitZone HitZone{ HitEnemy->GetHitZone(BeamHitResult.BoneName) };
+			const float ZoneMultiplier{ HitEnemy->GetHitZoneMultiplier(HitZone) };
+			if (HitZone == EHitZone::EHZ_Head)
+			{
+				//! Head Shot
+				Damage = Request.DamageModel.Evaluate(Request.HeadShotDamage, Distance, ZoneMultiplier);
+				HeadShot = true;
+			}
+			else
+			{
+				//! Body Shot
+				Damage = Request.DamageModel.Evaluate(Request.Damage, Distance, ZoneMultiplier);
+				HeadShot = false;
+			}
+
+			// UE_LOG(LogTemp, Warning, TEXT("Bone hit: %s"), *BeamHitResult.BoneName.ToString());
+			//! Hit Number and damage are applied with the rest of this frame's damage
+			UDamagePipelineSubsystem::QueueHitDamage(this, HitEnemy, Damage, GetController(), this, BeamHitResult.Location, HeadShot);
+
+		}
+		else
+		{
+			//! Spawn default particles
+			if(ImpactParticles)
+			{
+				UFXBudgetSubsystem::SpawnEmitterAtLocation(this, ImpactParticles, FTransform(BeamHitResult.Location));
+			}
+		}
+	}
+	else
 	{
-		OutHitResult.Location = OutBeamLocation;
-		return false;
+		//! Spawn default particles
+		if(ImpactParticles)
+		{
+			UFXBudgetSubsystem::SpawnEmitterAtLocation(this, ImpactParticles, FTransform(BeamHitResult.Location));
+		}
 	}
 
-	return true;
+	//! After Line Traces spawn Impact and Beam particles
+	if(BeamParticles)
+	{
+		UParticleSystemComponent* Beam = UFXBudgetSubsystem::SpawnEmitterAtLocation(this, BeamParticles, Request.BarrelTransform);
+		
+		if(Beam)
+		{
+			Beam->SetVectorParameter(FName("Target"), BeamHitResult.Location);
+		}
+	}
 }
 
 void AShooterCharacter::AimingButtonPressed()
@@ -426,7 +570,7 @@ void AShooterCharacter::AutoFireReset()
 	}
 }
 
-bool AShooterCharacter::TraceUnderCrosshair(FHitResult& OutHitResult, FVector& OutHitLocation)
+bool AShooterCharacter::GetCrosshairRay(FVector& OutStart, FVector& OutEnd)
 {
 	//! Get current size of the viewport
 	FVector2D ViewportSize;
@@ -448,16 +592,78 @@ bool AShooterCharacter::TraceUnderCrosshair(FHitResult& OutHitResult, FVector& O
 	if (bScreenToWorld)
 	{
 		//! Trace from crosshair world location outward
-		const FVector Start{ CrosshairWorldPosition };
-		const FVector End{ Start + CrosshairWorldDirection * 50'000.f };
+		OutStart = CrosshairWorldPosition;
+		OutEnd = OutStart + CrosshairWorldDirection * 50'000.f;
+	}
+
+	return bScreenToWorld;
+}
+
+bool AShooterCharacter::GetAimRayView(FVector& OutCameraLocation, FRotator& OutCameraRotation, FVector2D& OutViewportSize) const
+{
+	const APlayerController* PlayerController = Cast<APlayerController>(GetController());
+	if (PlayerController == nullptr || PlayerController->PlayerCameraManager == nullptr) return false;
+
+	OutCameraLocation = PlayerController->PlayerCameraManager->GetCameraLocation();
+	OutCameraRotation = PlayerController->PlayerCameraManager->GetCameraRotation();
+
+	OutViewportSize = FVector2D::ZeroVector;
+	if (GEngine && GEngine->GameViewport)
+	{
+		GEngine->GameViewport->GetViewportSize(OutViewportSize);
+	}
+
+	return true;
+}
+
+bool AShooterCharacter::IsAimRayCacheValid() const
+{
+	if (!AimRayCache.bValid || AimRayCache.Frame != GFrameCounter) return false;
+
+	FVector CameraLocation;
+	FRotator CameraRotation;
+	FVector2D ViewportSize;
+	if (!GetAimRayView(CameraLocation, CameraRotation, ViewportSize)) return false;
+
+	//! Camera moved or viewport was resized since the ray was traced
+	return CameraLocation.Equals(AimRayCache.CameraLocation) && 
+		CameraRotation.Equals(AimRayCache.CameraRotation) && 
+		ViewportSize == AimRayCache.ViewportSize;
+}
+
+bool AShooterCharacter::TraceUnderCrosshair(FHitResult& OutHitResult, FVector& OutHitLocation)
+{
+	if (IsAimRayCacheValid())
+	{
+		INC_DWORD_STAT(STAT_AimRayTracesSaved);
+		OutHitResult = AimRayCache.HitResult;
+		OutHitLocation = AimRayCache.HitLocation;
+		return AimRayCache.bHit;
+	}
+
+	AimRayCache.bValid = false;
+
+	FVector Start;
+	FVector End;
+	if (GetCrosshairRay(Start, End))
+	{
 		OutHitLocation = End;
 
 		GetWorld()->LineTraceSingleByChannel(OutHitResult,Start,End,ECollisionChannel::ECC_Visibility);
+		INC_DWORD_STAT(STAT_AimRayTraces);
 		if(OutHitResult.bBlockingHit)
 		{
 			OutHitLocation = OutHitResult.Location;
-			return true;
 		}
+
+		//! Remember the ray for the rest of the frame
+		AimRayCache.bValid = GetAimRayView(AimRayCache.CameraLocation, AimRayCache.CameraRotation, AimRayCache.ViewportSize);
+		AimRayCache.Frame = GFrameCounter;
+		AimRayCache.HitResult = OutHitResult;
+		AimRayCache.HitLocation = OutHitLocation;
+		AimRayCache.bHit = OutHitResult.bBlockingHit;
+
+		return OutHitResult.bBlockingHit;
 	}
 
 	return false;
@@ -465,64 +671,81 @@ bool AShooterCharacter::TraceUnderCrosshair(FHitResult& OutHitResult, FVector& O
 
 void AShooterCharacter::TraceForItems()
 {
+	SCOPE_CYCLE_COUNTER(STAT_TraceForItems);
+
 	if (bShouldTraceForItems)
 	{
-		FHitResult ItemTraceResult;
-		FVector HitLocation;
-		bool result = TraceUnderCrosshair(ItemTraceResult,HitLocation);
-		if(result)
+		AItem* BestCandidate = PickFocusCandidate();
+
+		//! The shared aim ray is traced every frame, firing later this frame reuses it
+		FHitResult AimHit;
+		FVector AimHitLocation;
+		const bool bAimHitsCandidate = TraceUnderCrosshair(AimHit, AimHitLocation) && BestCandidate && AimHit.GetActor() == BestCandidate;
+
+		const float WorldTime = GetWorld()->GetTimeSeconds();
+		if (bAimHitsCandidate)
+		{
+			bFocusedCandidateVisible = true;
+			LastFocusOcclusionTime = WorldTime;
+		}
+		else if (BestCandidate != FocusedCandidate.Get() || WorldTime - LastFocusOcclusionTime >= FocusOcclusionInterval)
 		{
-			TraceHitItem = Cast<AItem>(ItemTraceResult.GetActor());
-			const AWeapon* TraceHitWeapon = Cast<AWeapon>(TraceHitItem);
-			if (TraceHitWeapon)
+			//! Only trace to the item when focus changes or the last occlusion check is too old
+			bFocusedCandidateVisible = BestCandidate && IsFocusCandidateVisible(BestCandidate);
+			LastFocusOcclusionTime = WorldTime;
+		}
+		FocusedCandidate = BestCandidate;
+
+		TraceHitItem = bFocusedCandidateVisible ? BestCandidate : nullptr;
+		const AWeapon* TraceHitWeapon = Cast<AWeapon>(TraceHitItem);
+		if (TraceHitWeapon)
+		{
+			if (HighlightedSlot == -1)
 			{
-				if (HighlightedSlot == -1)
-				{
-					//! Not currently highlighting slot; highlight it
-					HighlightInventorySlot();
-				}
+				//! Not currently highlighting slot; highlight it
+				HighlightInventorySlot();
 			}
-			else
+		}
+		else
+		{
+			//! Is a slot being highlighted
+			if (HighlightedSlot != -1)
 			{
-				//! Is a slot being highlighted
-				if (HighlightedSlot != -1)
-				{
-					UnHighlightInventorySlot();
-				}
+				UnHighlightInventorySlot();
 			}
+		}
 
-			if (TraceHitItem && TraceHitItem->GetItemState() == EItemState::EIS_EquipInterping)
-			{
-				TraceHitItem = nullptr;
-			}
+		if (TraceHitItem && TraceHitItem->GetItemState() == EItemState::EIS_EquipInterping)
+		{
+			TraceHitItem = nullptr;
+		}
+
+		if(TraceHitItem != nullptr && TraceHitItem->GetPickupWidget() != nullptr)
+		{
+			TraceHitItem->GetPickupWidget()->SetVisibility(true);
+			TraceHitItem->EnableCustomDepth();
 
-			if(TraceHitItem != nullptr && TraceHitItem->GetPickupWidget() != nullptr)
+			if (Inventory.Num() >= INVENTORY_CAPACITY)
 			{
-				TraceHitItem->GetPickupWidget()->SetVisibility(true);
-				TraceHitItem->EnableCustomDepth();
-
-				if (Inventory.Num() >= INVENTORY_CAPACITY)
-				{
-					//! Inventory full
-					TraceHitItem->SetCharacterInventoryFull(true);
-				}
-				else
-				{
-					//! Inventory has space
-					TraceHitItem->SetCharacterInventoryFull(false);
-				}
-			} 
-
-			if (TraceHitItemLastFrame != TraceHitItem)
+				//! Inventory full
+				TraceHitItem->SetCharacterInventoryFull(true);
+			}
+			else
 			{
-				if (TraceHitItemLastFrame)
-				{
-					TraceHitItemLastFrame->GetPickupWidget()->SetVisibility(false);
-					TraceHitItemLastFrame->DisableCustomDepth();
-				}
+				//! Inventory has space
+				TraceHitItem->SetCharacterInventoryFull(false);
 			}
-			TraceHitItemLastFrame = TraceHitItem;
 		} 
+
+		if (TraceHitItemLastFrame != TraceHitItem)
+		{
+			if (TraceHitItemLastFrame)
+			{
+				TraceHitItemLastFrame->GetPickupWidget()->SetVisibility(false);
+				TraceHitItemLastFrame->DisableCustomDepth();
+			}
+		}
+		TraceHitItemLastFrame = TraceHitItem;
 	}
 	else if (TraceHitItemLastFrame)
 	{
@@ -532,6 +755,66 @@ void AShooterCharacter::TraceForItems()
 	}
 }
 
+AItem* AShooterCharacter::PickFocusCandidate() const
+{
+	SET_DWORD_STAT(STAT_ItemFocusCandidates, FocusCandidates.Num());
+
+	FVector CameraLocation;
+	FRotator CameraRotation;
+	FVector2D ViewportSize;
+	if (!GetAimRayView(CameraLocation, CameraRotation, ViewportSize)) return nullptr;
+
+	const FVector CameraForward{ CameraRotation.Vector() };
+	const float MinDot{ FMath::Cos(FMath::DegreesToRadians(FocusConeAngle)) };
+
+	AItem* BestCandidate{ nullptr };
+	float BestDot{ -1.f };
+
+	for (const TWeakObjectPtr<AItem>& CandidatePtr : FocusCandidates)
+	{
+		AItem* Candidate = CandidatePtr.Get();
+		if (Candidate == nullptr || Candidate->GetItemState() == EItemState::EIS_EquipInterping) continue;
+
+		const FBoxSphereBounds& Bounds = Candidate->GetCollisionBox()->Bounds;
+		const FVector ToCandidate{ Bounds.Origin - CameraLocation };
+		const float Distance{ static_cast<float>(ToCandidate.Size()) };
+		if (Distance <= KINDA_SMALL_NUMBER) continue;
+
+		const float Dot{ static_cast<float>(FVector::DotProduct(CameraForward, ToCandidate)) / Distance };
+		if (Dot <= 0.f) continue;
+
+		//! Big items close to the camera can be under the crosshair while their center is outside of the cone
+		const float DistanceFromRay{ static_cast<float>(FVector::CrossProduct(CameraForward, ToCandidate).Size()) };
+		if (Dot < MinDot && DistanceFromRay > Bounds.SphereRadius) continue;
+
+		if (Dot > BestDot)
+		{
+			BestDot = Dot;
+			BestCandidate = Candidate;
+		}
+	}
+
+	return BestCandidate;
+}
+
+bool AShooterCharacter::IsFocusCandidateVisible(AItem* Candidate) const
+{
+	FVector CameraLocation;
+	FRotator CameraRotation;
+	FVector2D ViewportSize;
+	if (!GetAimRayView(CameraLocation, CameraRotation, ViewportSize)) return false;
+
+	FCollisionQueryParams QueryParams;
+	QueryParams.AddIgnoredActor(this);
+
+	FHitResult OcclusionHit;
+	GetWorld()->LineTraceSingleByChannel(OcclusionHit, CameraLocation, Candidate->GetCollisionBox()->Bounds.Origin, 
+		ECollisionChannel::ECC_Visibility, QueryParams);
+	INC_DWORD_STAT(STAT_ItemFocusOcclusionTraces);
+
+	return !OcclusionHit.bBlockingHit || OcclusionHit.GetActor() == Candidate;
+}
+
 AWeapon* AShooterCharacter::SpawnDefaultWeapon()
 {
 	//! Check the TsubClassOf variable 
@@ -548,7 +831,7 @@ void AShooterCharacter::EquipWeapon(AWeapon* WeaponToEquip, bool bSwapping)
 {
 	if (WeaponToEquip)
 	{
-		const USkeletalMeshSocket* HandSocket = GetMesh()->GetSocketByName(FName("RightHandSocket"));
+		const USkeletalMeshSocket* HandSocket = RightHandSocket.Get(this, GetMesh(), FName("RightHandSocket"));
 		if (HandSocket)
 		{
 			//! Attach the weapon to the RightHandSocket
@@ -634,7 +917,7 @@ void AShooterCharacter::PlayFireSound()
 	//! Play fire sound
 	if (EquippedWeapon->GetFireSound()) 
 	{
-		UGameplayStatics::PlaySound2D(this,EquippedWeapon->GetFireSound());
+		USoundDispatchSubsystem::PlaySound2D(this, EquippedWeapon->GetFireSound(), ESoundCategory::ESC_WeaponFire);
 	}
 }
 
@@ -642,83 +925,17 @@ void AShooterCharacter::SendBullet()
 {
 	if (EquippedWeapon->GetMuzzleFlash())
 	{
-		UGameplayStatics::SpawnEmitterAttached(EquippedWeapon->GetMuzzleFlash(),EquippedWeapon->GetItemMesh(),TEXT("BarrelSocket"));
+		UFXBudgetSubsystem::SpawnEmitterAttached(EquippedWeapon->GetMuzzleFlash(),EquippedWeapon->GetItemMesh(),EquippedWeapon->GetBarrelSocketName());
 	}
 
 	//! Send Bullet
-	const USkeletalMeshSocket* BarrelSocket = EquippedWeapon->GetItemMesh()->GetSocketByName(TEXT("BarrelSocket"));
+	const USkeletalMeshSocket* BarrelSocket = EquippedWeapon->GetBarrelSocket();
 	if(BarrelSocket)
 	{
 		const FTransform SocketTransform = BarrelSocket->GetSocketTransform(EquippedWeapon->GetItemMesh());
 
-		FHitResult BeamHitResult;
-
-		bool bBeamEndSuccess = GetBeamEndLocation(SocketTransform.GetLocation(), BeamHitResult);
-		if (bBeamEndSuccess)
-		{
-
-			if (BeamHitResult.GetActor())
-			{
-				IBulletHitInterface* HitInterface = Cast<IBulletHitInterface>(BeamHitResult.GetActor());
-				if (HitInterface)
-				{
-					HitInterface->BulletHit_Implementation(BeamHitResult, this, GetController());
-				}
-
-				AEnemy* HitEnemy = Cast<AEnemy>(BeamHitResult.GetActor());
-				if (HitEnemy)
-				{
-					int32 Damage{};
-					bool HeadShot{};
-					if (BeamHitResult.BoneName.ToString() == HitEnemy->GetHeadBone())
-					{
-						//! Head Shot
-						Damage = EquippedWeapon->GetHeadShotDamage();
-						HeadShot = true;
-					}
-					else
-					{
-						//! Body Shot
-						Damage = EquippedWeapon->GetDamage();
-						HeadShot = false;
-					}
-
-					HitEnemy->ShowHitNumber(Damage, BeamHitResult.Location, HeadShot);
-					// UE_LOG(LogTemp, Warning, TEXT("Bone hit: %s"), *BeamHitResult.BoneName.ToString());
-					UGameplayStatics::ApplyDamage(BeamHitResult.GetActor(), Damage, GetController(), this, UDamageType::StaticClass());
-
-				}
-				else
-				{
-					//! Spawn default particles
-					if(ImpactParticles)
-					{
-						UGameplayStatics::SpawnEmitterAtLocation(GetWorld(), ImpactParticles, BeamHitResult.Location);
-					}
-				}
-			}
-			else
-			{
-				//! Spawn default particles
-				if(ImpactParticles)
-				{
-					UGameplayStatics::SpawnEmitterAtLocation(GetWorld(), ImpactParticles, BeamHitResult.Location);
-				}
-			}
-			
-			 
-			//! After Line Traces spawn Impact and Beam particles
-			if(BeamParticles)
-			{
-				UParticleSystemComponent* Beam = UGameplayStatics::SpawnEmitterAtLocation(GetWorld(), BeamParticles, SocketTransform);
-				
-				if(Beam)
-				{
-					Beam->SetVectorParameter(FName("Target"), BeamHitResult.Location);
-				}
-			}
-		}	
-
+		//! Line traces are done async, the hit is resolved in ProcessHitscans
+		QueueHitscan(SocketTransform);
 	}
 }
 
@@ -840,7 +1057,7 @@ void AShooterCharacter::GrabClip()
 	if (HandSceneComponent == nullptr) return;
 
 	//! Index for the clip bone on the equipped weapon
-	int32 ClipBoneIndex{ EquippedWeapon->GetItemMesh()->GetBoneIndex(EquippedWeapon->GetClipBoneName()) };
+	int32 ClipBoneIndex{ EquippedWeapon->GetClipBoneIndex() };
 	ClipTransform = EquippedWeapon->GetItemMesh()->GetBoneTransform(ClipBoneIndex);
 
 	FAttachmentTransformRules AttachmentRules(EAttachmentRule::KeepRelative, true);
@@ -948,7 +1165,16 @@ void AShooterCharacter::PickupAmmo(class AAmmo* Ammo)
 		}
 	}
 
-	Ammo->Destroy();
+	//! Ammo actor goes back to the loot pool for the next drop
+	ULootPoolSubsystem* LootPool = ULootPoolSubsystem::Get(this);
+	if (LootPool)
+	{
+		LootPool->ReleaseItem(Ammo);
+	}
+	else
+	{
+		Ammo->Destroy();
+	}
 }
 
 void AShooterCharacter::InitializeInterpLocations()
@@ -1212,6 +1438,8 @@ void AShooterCharacter::Tick(float DeltaTime)
 	CalculateCrosshairSpread(DeltaTime);
 	//! Cheched OverlappedItemCount, then trace for items 
 	TraceForItems();
+	//! Resolve the shots whose line traces came back
+	ProcessHitscans();
 	//! Interpolate the capsule half height based on crouching/standing
 	InterpCapsuleHalfHeight(DeltaTime);
 
@@ -1274,8 +1502,8 @@ float AShooterCharacter::TakeDamage(float DamageAmount, struct FDamageEvent cons
 		AEnemyController* EnemyController = Cast<AEnemyController>(EventInstigator);
 		if (EnemyController)
 		{
-			EnemyController->GetBlackboardComponent()->SetValueAsBool(FName("CharacterDead"), true);
-			EnemyController->GetBlackboardComponent()->SetValueAsObject(FName("Target"), nullptr);
+			EnemyController->SetCharacterDead(true);
+			EnemyController->SetTarget(nullptr);
 		}
 	}
 	else
@@ -1317,6 +1545,56 @@ void AShooterCharacter::IncrementOverlappedItemCount(int8 Amount)
 	}
 }
 
+void AShooterCharacter::AddFocusCandidate(AItem* Item)
+{
+	FocusCandidates.AddUnique(Item);
+	IncrementOverlappedItemCount(1);
+
+	//! Weapon might be picked up, stream in the rest of its assets
+	AWeapon* Weapon = Cast<AWeapon>(Item);
+	if (Weapon)
+	{
+		if (UItemDataSubsystem* ItemData = UItemDataSubsystem::Get(this))
+		{
+			ItemData->RequestWeaponAssets(Weapon->GetWeaponType());
+		}
+	}
+}
+
+void AShooterCharacter::RemoveFocusCandidate(AItem* Item)
+{
+	//! Only counted once, a parked item is removed here before its end overlap arrives
+	const int32 NumRemoved = FocusCandidates.RemoveAll([Item](const TWeakObjectPtr<AItem>& Candidate) { return Candidate.Get() == Item; });
+	//! Also drop candidates that were destroyed while in range
+	FocusCandidates.RemoveAll([](const TWeakObjectPtr<AItem>& Candidate) { return !Candidate.IsValid(); });
+	if (NumRemoved > 0)
+	{
+		IncrementOverlappedItemCount(-1);
+	}
+}
+
+void AShooterCharacter::ClearItemFocus(AItem* Item)
+{
+	if (Item == nullptr) return;
+
+	RemoveFocusCandidate(Item);
+
+	if (FocusedCandidate.Get() == Item)
+	{
+		FocusedCandidate = nullptr;
+		bFocusedCandidateVisible = false;
+	}
+	if (TraceHitItem == Item)
+	{
+		TraceHitItem = nullptr;
+		UnHighlightInventorySlot();
+	}
+	if (TraceHitItemLastFrame == Item)
+	{
+		TraceHitItemLastFrame = nullptr;
+	}
+}
+
 //! No longer needed AItem has its own GetInterpLocation
 // FVector AShooterCharacter::GetCameraInterpLocation()
 // {
@@ -1434,6 +1712,23 @@ void AShooterCharacter::Stun(EHitDirection Direction)
 	}
 }
 
+const USkeletalMeshSocket* AShooterCharacter::GetBloodSocket(EHitDirection Side)
+{
+	switch (Side)
+	{
+		case EHitDirection::Front:
+			return BloodSockets[static_cast<int32>(Side)].Get(this, GetMesh(), ForwardBloodSocketName);
+		case EHitDirection::Back:
+			return BloodSockets[static_cast<int32>(Side)].Get(this, GetMesh(), BackBloodSocketName);
+		case EHitDirection::Left:
+			return BloodSockets[static_cast<int32>(Side)].Get(this, GetMesh(), LeftBloodSocketName);
+		case EHitDirection::Right:
+			return BloodSockets[static_cast<int32>(Side)].Get(this, GetMesh(), RightBloodSocketName);
+		default:
+			return nullptr;
+	}
+}
+
 void AShooterCharacter::CharacterWon()
 {
 	bGameEnded = true;
@@ -4,8 +4,11 @@
 
 #include "CoreMinimal.h"
 #include "GameFramework/Character.h"
+#include "WorldCollision.h"
 #include "UltimateShooter/Enums/AmmoType.h"
 #include "UltimateShooter/Enums/HitDirection.h"
+#include "UltimateShooter/Weapons/WeaponDamage.h"
+#include "UltimateShooter/Subsystems/SocketCacheSubsystem.h"
 #include "ShooterCharacter.generated.h"
 
 /**
@@ -42,6 +45,68 @@ struct FInterpLocation
 	int32 ItemCount;
 };
 
+/**
+ * @brief A single shot waiting for its async line traces to come back.
+ * 
+ * Shots keep the crosshair-then-barrel order of the old synchronous path: the crosshair trace goes out on the frame
+ * the weapon fires, the barrel trace goes out when the crosshair result is in, and damage and particles are resolved
+ * once the barrel result is in.
+ */
+struct FHitscanRequest
+{
+	//! Barrel socket transform when the shot was fired, start of the barrel trace and the beam particles
+	FTransform BarrelTransform;
+
+	//! End of the crosshair trace, used as the beam end when the crosshair trace hits nothing
+	FVector CrosshairEnd{ FVector::ZeroVector };
+
+	//! Handle of the trace that is currently in flight for this shot
+	FTraceHandle TraceHandle;
+
+	//! Body and head shot damage of the weapon at the moment it fired
+	float Damage{ 0.f };
+	float HeadShotDamage{ 0.f };
+
+	//! Damage falloff of the weapon at the moment it fired
+	FWeaponDamageModel DamageModel;
+
+	//! World time in seconds when the shot was fired, used for latency stats
+	double FireTime{ 0.0 };
+
+	//! True once the crosshair trace came back and the barrel trace is in flight
+	bool bBarrelTraceInFlight{ false };
+};
+
+/**
+ * @brief Result of the crosshair line trace, shared by item highlighting and firing for the rest of the frame.
+ * 
+ * Only valid during the frame it was traced on and while the camera stays where it was when it was traced.
+ */
+struct FAimRayCache
+{
+	//! Result of the crosshair line trace
+	FHitResult HitResult;
+
+	//! Blocking hit location, or the end of the ray if nothing was hit
+	FVector HitLocation{ FVector::ZeroVector };
+
+	//! Camera location and rotation when the ray was deprojected
+	FVector CameraLocation{ FVector::ZeroVector };
+	FRotator CameraRotation{ FRotator::ZeroRotator };
+
+	//! Viewport size when the ray was deprojected
+	FVector2D ViewportSize{ FVector2D::ZeroVector };
+
+	//! GFrameCounter of the frame the ray was traced on
+	uint64 Frame{ 0 };
+
+	//! True if the crosshair line trace had a blocking hit
+	bool bHit{ false };
+
+	//! False until the first trace and after the cache is invalidated
+	bool bValid{ false };
+};
+
 /**
  * @brief Broadcasts when an item is equipped, passing current and new slot indices.
  * 
@@ -156,20 +221,62 @@ protected:
 	void FireWeapon();
 
 	/**
-	 * @brief Get the Beam End Location object
+	 * @brief Gets the world space ray going through the crosshair in the middle of the screen
+	 * 
+	 * Gets the viewport size and deprojects its center into the world.
+	 * 
+	 * @param OutStart World location of the crosshair on the near plane
+	 * @param OutEnd Point 50'000 units away from OutStart in the crosshair direction
+	 * @return true If DeprojectScreenToWorld is successfull
+	 * @return false If there is no viewport or player controller to deproject with
+	 */
+	bool GetCrosshairRay(FVector& OutStart, FVector& OutEnd);
+
+	/**
+	 * @brief Sends the crosshair async line trace for a shot and adds the shot to the PendingHitscans queue
 	 * 
-	 * After the Trace Under Crosshair function call which will return the result of the Line Trace from camera to crosshair
-	 * we will perform the second line trace which will go from the Muzzle Socket Location to the End of the first line trace to
-	 * make sure there are no objects in between the crosshair and muzzle socket that could block the bullet.
+	 * If the crosshair was already traced this frame only the barrel trace is sent and the shot resolves next frame.
+	 * Otherwise the barrel trace can only go out once the crosshair trace is back, so the shot resolves two frames
+	 * after it was fired. STAT_HitscanLatency shows which case shots hit.
 	 * 
-	 * @param MuzzleSocketLocation Location of the Muzzle Socket that is placed on top of the Gun Barrel
-	 * @param OutHitResult FHitResult output parameter that will be used in Send Bullet function
-	 * @return true 
-	 * @return false 
+	 * @param BarrelTransform Transform of the Barrel Socket when the weapon fired
 	 * 
-	 * @see TraceUnderCrosshair(FHitResult& OutHitResult,FVector& OutHitLocation)
+	 * @see ProcessHitscans()
 	 */
-	bool GetBeamEndLocation(const FVector& MuzzleSocketLocation, FHitResult& OutHitResult);
+	void QueueHitscan(const FTransform& BarrelTransform);
+
+	/**
+	 * @brief Sends the async barrel trace of a shot from the Barrel Socket towards the crosshair hit location
+	 * 
+	 * The trace goes a quarter past BeamEnd so the bullet still hits the surface the crosshair is on.
+	 * 
+	 * @param Request Shot the barrel trace is sent for
+	 * @param BeamEnd Crosshair hit location, or the end of the crosshair ray if nothing was hit
+	 */
+	void SendBarrelTrace(FHitscanRequest& Request, const FVector& BeamEnd);
+
+	/**
+	 * @brief Collects the async trace results for all shots in the PendingHitscans queue
+	 * 
+	 * Function called in Tick.
+	 * When the crosshair trace of a shot is back, sends the barrel trace from the Barrel Socket towards the crosshair
+	 * hit location to make sure there are no objects in between the crosshair and the muzzle that could block the bullet.
+	 * When the barrel trace is back, the shot is resolved and removed from the queue.
+	 * 
+	 * @see ResolveHitscan(const FHitscanRequest& Request, const FHitResult& BeamHitResult)
+	 */
+	void ProcessHitscans();
+
+	/**
+	 * @brief Calls BulletHit on the hit actor, applies damage to it and spawns Impact and Beam Particles
+	 * 
+	 * If the actor implements IBulletHitInterface calls BulletHit_Implementation on it, and if the Actor is Enemy
+	 * we will ApplyDamage. Otherwise default Impact Particles are spawned at the hit location.
+	 * 
+	 * @param Request Shot that is being resolved
+	 * @param BeamHitResult Result of the barrel trace of the shot
+	 */
+	void ResolveHitscan(const FHitscanRequest& Request, const FHitResult& BeamHitResult);
 
 	//! Set bAiming and zoom camera FOV in and out
 	/**
@@ -291,24 +398,70 @@ protected:
 	 * @param OutHitLocation If Line trace is successfull it will have it's Location, if not it will have End passed into Line Trace
 	 * @return true If DeprojectScreenToWorld is successfull and Line Trace has a Blocking Hit
 	 * @return false If DeprojectScreenToWorld is not successfull
+	 * 
+	 * The result is kept in AimRayCache, and calls later in the same frame reuse it instead of tracing again as long
+	 * as the camera has not moved.
+	 * 
+	 * @see IsAimRayCacheValid()
 	 */
 	bool TraceUnderCrosshair(FHitResult& OutHitResult,FVector& OutHitLocation);
 
+	/**
+	 * @brief Checks if AimRayCache can still be used
+	 * 
+	 * @return true If the ray was traced this frame and the camera and viewport did not change since
+	 * @return false If there is no cached ray or it went stale
+	 */
+	bool IsAimRayCacheValid() const;
+
+	/**
+	 * @brief Gets the current camera location, rotation and viewport size the crosshair ray is deprojected with
+	 * 
+	 * @return true If there is a player camera manager to read from
+	 */
+	bool GetAimRayView(FVector& OutCameraLocation, FRotator& OutCameraRotation, FVector2D& OutViewportSize) const;
+
 	//! Trace for items if OverlappedItemCount > 0
 	/**
-	 * @brief If Items are nearby it will perform a line trace and display its widget and highlight the inventory slot
+	 * @brief If Items are nearby it will pick the one under the crosshair, display its widget and highlight the inventory slot
 	 * 
-	 * If bShouldTraceForItems is true than we will call Trace Under Crosshair function and if it is successfull we will use its output
-	 * parameters to determine if we traced Item, if it is we will Display his widget and if it is also a weapon, 
-	 * we will Highlight the Inventory slot and if it isnt we will Unhighlight it. Also if we traced multiple items in a row
-	 * we will remember Traced Item Last Frame and Hide its Widget, we will also do it if bShouldTraceForItems is false.
+	 * If bShouldTraceForItems is true than we will pick the focused item from FocusCandidates, if there is one we will Display
+	 * his widget and if it is also a weapon, we will Highlight the Inventory slot and if it isnt we will Unhighlight it. 
+	 * Also if we focused multiple items in a row we will remember Traced Item Last Frame and Hide its Widget, we will also 
+	 * do it if bShouldTraceForItems is false.
 	 * 
-	 * @see TraceUnderCrosshair(FHitResult& OutHitResult,FVector& OutHitLocation)
+	 * The aim ray is traced through TraceUnderCrosshair every frame, so it lands in AimRayCache for shots fired later
+	 * in the frame. If it hits the focused item, the item is visible. Otherwise a line trace straight to the item checks
+	 * that nothing is standing between the camera and the item, only when the focused item changes or every
+	 * FocusOcclusionInterval seconds.
+	 * 
+	 * @see PickFocusCandidate()
+	 * @see IsFocusCandidateVisible(AItem* Candidate)
+	 * @see TraceUnderCrosshair(FHitResult& OutHitResult, FVector& OutHitLocation)
 	 * @see HighlightInventorySlot()
 	 * @see UnHighlightInventorySlot()
 	 */
 	void TraceForItems();
 
+	/**
+	 * @brief Picks the item from FocusCandidates that is closest to the middle of the screen
+	 * 
+	 * Each candidate is scored by the dot product of the camera forward vector and the direction from the camera to the
+	 * item. Only items inside the FocusConeAngle cone, or items the crosshair ray passes through, can be picked.
+	 * 
+	 * @return AItem* Best candidate, or nullptr if no candidate is under the crosshair
+	 */
+	AItem* PickFocusCandidate() const;
+
+	/**
+	 * @brief Line traces from the camera to the Candidate to check it is not hidden behind something
+	 * 
+	 * @param Candidate Item to check
+	 * @return true If the trace hits the Candidate or nothing at all
+	 * @return false If something else blocks the trace first
+	 */
+	bool IsFocusCandidateVisible(AItem* Candidate) const;
+
 	//! Spawns default weapon
 	/**
 	 * @brief If DefaultWeaponClass is set we will spawn weapon based on that class and return it
@@ -370,13 +523,13 @@ protected:
 	void PlayFireSound();
 
 	/**
-	 * @brief Spawns Particles and calss BulletHit_Implementation on hit actor and applyes damage to it
+	 * @brief Spawns Muzzle Flash Particles and queues the bullet line traces
 	 * 
-	 * Spawns Muzzle Flash Particles, calls GetBeamEndLocation function and passes BarrelSocketTransform. If it is 
-	 * succesfull we will get the hit actor, if that Actor Implements IBulletHitInterface calls BulletHit_Implementation on it,
-	 * and if Actor is Enemy we will ApplyDamage. Also spawns Impact and Beam Particles at the end.
+	 * Spawns Muzzle Flash Particles and calls QueueHitscan with the BarrelSocket transform. Traces are done
+	 * asynchronously and the hit is resolved into damage and particles on the next frames.
 	 * 
-	 * @see GetBeamEndLocation(const FVector& MuzzleSocketLocation, FHitResult& OutHitResult)
+	 * @see QueueHitscan(const FTransform& BarrelTransform)
+	 * @see ProcessHitscans()
 	 */
 	void SendBullet();
 
@@ -787,6 +940,24 @@ private:
 	UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Category = Items, meta = (AllowPrivateAccess = "true"))
 	class AItem* TraceHitItemLastFrame;
 
+	//! Items whose AreaSphere we are overlapping, TraceForItems picks the focused item from them
+	TArray<TWeakObjectPtr<AItem>> FocusCandidates;
+
+	//! Best candidate picked last frame and the result of its last occlusion trace
+	TWeakObjectPtr<AItem> FocusedCandidate;
+	bool bFocusedCandidateVisible;
+
+	//! World time of the last occlusion trace on FocusedCandidate
+	float LastFocusOcclusionTime;
+
+	//! Half angle in degrees of the cone in front of the camera inside which items can be focused
+	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = Items, meta = (AllowPrivateAccess = "true"))
+	float FocusConeAngle;
+
+	//! Seconds between occlusion traces while the focused item stays the same
+	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = Items, meta = (AllowPrivateAccess = "true"))
+	float FocusOcclusionInterval;
+
 	//! Currently equipped Weapon
 	UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Category = Combat, meta = (AllowPrivateAccess = "true"))
 	AWeapon* EquippedWeapon;
@@ -960,6 +1131,12 @@ private:
 	
 	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = Combat, meta = (AllowPrivateAccess = "true"))
 	FName BackBloodSocketName;
+
+	//! Blood sockets resolved on the character mesh, indexed by EHitDirection
+	FCachedSocket BloodSockets[4];
+
+	//! Socket the equipped weapon is attached to
+	FCachedSocket RightHandSocket;
 	
 	//! Hit React anim montage for when character is stunned
 	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = Combat, meta = (AllowPrivateAccess = "true"))
@@ -990,6 +1167,12 @@ private:
 	float StunnedWidgetDuration;
 
 	bool bGameEnded;
+
+	//! Shots whose line traces are still in flight
+	TArray<FHitscanRequest> PendingHitscans;
+
+	//! Crosshair line trace result of the current frame
+	FAimRayCache AimRayCache;
 	
 public:
 
@@ -1009,6 +1192,27 @@ public:
 	 */
 	void IncrementOverlappedItemCount(int8 Amount);
 
+	/**
+	 * @brief Called when character begins overlap with Item's sphere, adds the Item to FocusCandidates
+	 * 
+	 * @param Item Item that is now in range
+	 */
+	void AddFocusCandidate(AItem* Item);
+
+	/**
+	 * @brief Called when character ends overlap with Item's sphere, removes the Item from FocusCandidates
+	 * 
+	 * @param Item Item that is no longer in range
+	 */
+	void RemoveFocusCandidate(AItem* Item);
+
+	/**
+	 * @brief Drops every reference to an item that is parked in the loot pool, so it can no longer be focused or picked up
+	 * 
+	 * @param Item Item that is being parked
+	 */
+	void ClearItemFocus(AItem* Item);
+
 	//! No Longer needed AItem has GetItemInterpLocation
 	//FVector GetCameraInterpLocation();
 
@@ -1093,6 +1297,14 @@ public:
 	 */
 	void Stun(EHitDirection Direction);
 
+	/**
+	 * @brief Gets the blood socket on the side of the character, resolved again only when the mesh changes
+	 * 
+	 * @param Side Front, Back, Left or Right
+	 * @return const USkeletalMeshSocket* Socket, or nullptr for EHitDirection::None or a mesh without the socket
+	 */
+	const USkeletalMeshSocket* GetBloodSocket(EHitDirection Side);
+
 	/**
 	 * @brief Indicates that game ended and plays WinningMontage and disables input
 	 * 
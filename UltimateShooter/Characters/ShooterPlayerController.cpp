@@ -6,9 +6,19 @@
 #include "ShooterCharacter.h"
 #include "Kismet/GameplayStatics.h"
 #include "Sound/SoundCue.h"
+#include "Engine/LocalPlayer.h"
+#include "Engine/GameViewportClient.h"
+#include "SceneView.h"
+#include "UltimateShooter/UltimateShooter.h"
+#include "UltimateShooter/Widgets/HitNumberWidget.h"
+
+DECLARE_DWORD_COUNTER_STAT(TEXT("Live Hit Numbers"), STAT_LiveHitNumbers, STATGROUP_UltimateShooter);
+DECLARE_DWORD_COUNTER_STAT(TEXT("Hit Number High Water Mark"), STAT_HitNumberHighWaterMark, STATGROUP_UltimateShooter);
+DECLARE_DWORD_COUNTER_STAT(TEXT("Hit Numbers Recycled Early"), STAT_HitNumbersRecycled, STATGROUP_UltimateShooter);
+DECLARE_CYCLE_STAT(TEXT("UpdateHitNumbers"), STAT_UpdateHitNumbers, STATGROUP_UltimateShooter);
 
 AShooterPlayerController::AShooterPlayerController() :
-    bGameEnded{false}
+    bGameEnded{false}, HitNumberPoolSize{32}, HitNumberLifeTime{1.5f}, NextHitNumberIndex{0}, HitNumberHighWaterMark{0}
 {
 
 }
@@ -74,4 +84,114 @@ void AShooterPlayerController::BeginPlay()
             HUDOverlay->SetVisibility(ESlateVisibility::Visible);
         }
     }
+
+    CreateHitNumberPool();
+}
+
+void AShooterPlayerController::Tick(float DeltaTime)
+{
+    Super::Tick(DeltaTime);
+
+    UpdateHitNumbers();
+}
+
+void AShooterPlayerController::CreateHitNumberPool()
+{
+    if (!IsLocalController() || HitNumberWidgetClass == nullptr) return;
+
+    HitNumberPool.Reserve(HitNumberPoolSize);
+    HitNumberLocations.Reserve(HitNumberPoolSize);
+    HitNumberSpawnTimes.Reserve(HitNumberPoolSize);
+    HitNumberWidgetIndices.Reserve(HitNumberPoolSize);
+
+    for (int32 i = 0; i < HitNumberPoolSize; i++)
+    {
+        UHitNumberWidget* HitNumber = CreateWidget<UHitNumberWidget>(this, HitNumberWidgetClass);
+        if (HitNumber)
+        {
+            HitNumber->AddToViewport();
+            HitNumber->SetVisibility(ESlateVisibility::Collapsed);
+            HitNumberPool.Add(HitNumber);
+        }
+    }
+}
+
+bool AShooterPlayerController::ShowHitNumber(int32 Damage, const FVector& HitLocation, bool HeadShot)
+{
+    if (HitNumberPool.Num() == 0) return false;
+
+    //! Widgets are used in ring order, so the oldest live Hit Number is the one about to be reused
+    if (HitNumberWidgetIndices.Num() == HitNumberPool.Num())
+    {
+        ReleaseOldestHitNumber();
+        INC_DWORD_STAT(STAT_HitNumbersRecycled);
+    }
+
+    const int32 WidgetIndex = NextHitNumberIndex;
+    NextHitNumberIndex = (NextHitNumberIndex + 1) % HitNumberPool.Num();
+
+    HitNumberLocations.Add(HitLocation);
+    HitNumberSpawnTimes.Add(GetWorld()->GetTimeSeconds());
+    HitNumberWidgetIndices.Add(WidgetIndex);
+
+    HitNumberHighWaterMark = FMath::Max(HitNumberHighWaterMark, HitNumberWidgetIndices.Num());
+
+    UHitNumberWidget* HitNumber = HitNumberPool[WidgetIndex];
+    HitNumber->OnHitNumberShown(Damage, HeadShot);
+
+    FVector2D ScreenLocation;
+    if (UGameplayStatics::ProjectWorldToScreen(this, HitLocation, ScreenLocation))
+    {
+        HitNumber->SetPositionInViewport(ScreenLocation);
+    }
+    HitNumber->SetVisibility(ESlateVisibility::HitTestInvisible);
+
+    return true;
+}
+
+void AShooterPlayerController::ReleaseOldestHitNumber()
+{
+    UHitNumberWidget* HitNumber = HitNumberPool[HitNumberWidgetIndices[0]];
+    HitNumber->SetVisibility(ESlateVisibility::Collapsed);
+    HitNumber->OnHitNumberHidden();
+
+    HitNumberLocations.RemoveAt(0, 1, false);
+    HitNumberSpawnTimes.RemoveAt(0, 1, false);
+    HitNumberWidgetIndices.RemoveAt(0, 1, false);
+}
+
+void AShooterPlayerController::UpdateHitNumbers()
+{
+    SCOPE_CYCLE_COUNTER(STAT_UpdateHitNumbers);
+
+    //! All Hit Numbers live equally long, so expired ones are always at the front
+    const float ExpiredSpawnTime = GetWorld()->GetTimeSeconds() - HitNumberLifeTime;
+    while (HitNumberSpawnTimes.Num() > 0 && HitNumberSpawnTimes[0] <= ExpiredSpawnTime)
+    {
+        ReleaseOldestHitNumber();
+    }
+
+    SET_DWORD_STAT(STAT_LiveHitNumbers, HitNumberWidgetIndices.Num());
+    SET_DWORD_STAT(STAT_HitNumberHighWaterMark, HitNumberHighWaterMark);
+
+    if (HitNumberWidgetIndices.Num() == 0) return;
+
+    ULocalPlayer* LocalPlayer = GetLocalPlayer();
+    if (LocalPlayer == nullptr || LocalPlayer->ViewportClient == nullptr) return;
+
+    //! Same projection UGameplayStatics::ProjectWorldToScreen does, but the matrix is built once for all Hit Numbers
+    FSceneViewProjectionData ProjectionData;
+    if (!LocalPlayer->GetProjectionData(LocalPlayer->ViewportClient->Viewport, ProjectionData)) return;
+
+    const FMatrix ViewProjectionMatrix{ ProjectionData.ComputeViewProjectionMatrix() };
+    const FIntRect ViewRect{ ProjectionData.GetConstrainedViewRect() };
+
+    for (int32 i = 0; i < HitNumberLocations.Num(); i++)
+    {
+        FVector2D ScreenLocation;
+        if (FSceneView::ProjectWorldToScreen(HitNumberLocations[i], ViewRect, ViewProjectionMatrix, ScreenLocation))
+        {
+            HitNumberPool[HitNumberWidgetIndices[i]]->SetPositionInViewport(ScreenLocation);
+        }
+    }
 }
\ No newline at end of file
@@ -36,6 +36,28 @@ public:
 	 */
 	virtual void GameHasEnded(class AActor* EndGameFocus = nullptr, bool bIsWinner = false) override;
 
+	/**
+	 * @brief Called every frame, moves the Hit Numbers on screen and returns expired ones to the pool
+	 * 
+	 * @param DeltaTime The time elapsed since the last frame.
+	 * 
+	 * @see UpdateHitNumbers()
+	 */
+	virtual void Tick(float DeltaTime) override;
+
+	/**
+	 * @brief Shows a Hit Number widget from the pool at the HitLocation
+	 * 
+	 * Widgets are taken from HitNumberPool in ring order, if all of them are on screen the oldest one is reused.
+	 * 
+	 * @param Damage damage amount to show
+	 * @param HitLocation world location at which the widget should be shown
+	 * @param HeadShot determines the color of the widget (true = yellow, false = white)
+	 * @return true If the Hit Number was shown
+	 * @return false If there is no pool, caller should fall back to creating its own widget
+	 */
+	bool ShowHitNumber(int32 Damage, const FVector& HitLocation, bool HeadShot);
+
 protected:
 
 	/**
@@ -46,6 +68,26 @@ protected:
 	 */
 	virtual void BeginPlay() override;
 
+	/**
+	 * @brief Creates HitNumberPoolSize Hit Number widgets, adds them to viewport and hides them
+	 * 
+	 */
+	void CreateHitNumberPool();
+
+	/**
+	 * @brief Returns expired Hit Numbers to the pool and projects the rest to the screen
+	 * 
+	 * All live Hit Numbers are projected in one pass with the view projection matrix of the local player, which is
+	 * computed once per frame instead of once per Hit Number.
+	 */
+	void UpdateHitNumbers();
+
+	/**
+	 * @brief Hides the widget of the oldest live Hit Number and removes it from the live arrays
+	 * 
+	 */
+	void ReleaseOldestHitNumber();
+
 private:
 	//! Refetence to the Overall HUD Overlay Blueprint Class
 	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = Widgets, meta = (AllowPrivateAccess = "true"))
@@ -69,6 +111,33 @@ private:
 	
 	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = Widgets, meta = (AllowPrivateAccess = "true"))
 	USoundCue* GameOverSound;
+
+	//! Hit Number widget class the pool is created from
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Hit Numbers", meta = (AllowPrivateAccess = "true"))
+	TSubclassOf<class UHitNumberWidget> HitNumberWidgetClass;
+
+	//! Number of Hit Number widgets created at BeginPlay
+	UPROPERTY(EditDefaultsOnly, BlueprintReadOnly, Category = "Hit Numbers", meta = (AllowPrivateAccess = "true"))
+	int32 HitNumberPoolSize;
+
+	//! Time before a Hit Number is removed from the screen
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Hit Numbers", meta = (AllowPrivateAccess = "true"))
+	float HitNumberLifeTime;
+
+	//! All Hit Number widgets, shown and hidden instead of created and destroyed
+	UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Category = "Hit Numbers", meta = (AllowPrivateAccess = "true"))
+	TArray<UHitNumberWidget*> HitNumberPool;
+
+	//! Index in HitNumberPool of the next widget to show
+	int32 NextHitNumberIndex;
+
+	//! Hit Numbers on screen, oldest first. Same index in all three arrays is the same Hit Number
+	TArray<FVector> HitNumberLocations;
+	TArray<float> HitNumberSpawnTimes;
+	TArray<int32> HitNumberWidgetIndices;
+
+	//! Most Hit Numbers that were on screen at the same time
+	int32 HitNumberHighWaterMark;
 	
 public:
 
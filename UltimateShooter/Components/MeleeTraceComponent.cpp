@@ -0,0 +1,189 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+
+#include "MeleeTraceComponent.h"
+#include "Components/SkeletalMeshComponent.h"
+#include "Engine/SkeletalMeshSocket.h"
+#include "GameFramework/Character.h"
+#include "Engine/World.h"
+#include "UltimateShooter/UltimateShooter.h"
+
+DECLARE_CYCLE_STAT(TEXT("Melee Trace"), STAT_MeleeTrace, STATGROUP_UltimateShooter);
+DECLARE_DWORD_COUNTER_STAT(TEXT("Melee Sweeps"), STAT_MeleeSweeps, STATGROUP_UltimateShooter);
+DECLARE_DWORD_COUNTER_STAT(TEXT("Melee Hits"), STAT_MeleeHits, STATGROUP_UltimateShooter);
+
+int32 MeleeTrace::GetNumSubSteps(float DeltaTime, float SubStepRate, int32 MaxSubSteps)
+{
+	//! 1/60 s at 120 sub-steps per second is 2 sub-steps, not 3 because of float error
+	return FMath::Clamp(FMath::CeilToInt(DeltaTime * SubStepRate - KINDA_SMALL_NUMBER), 1, FMath::Max(MaxSubSteps, 1));
+}
+
+FVector MeleeTrace::GetSubStepLocation(const FTransform& LastComponentTransform, const FVector& LastLocalLocation,
+	const FTransform& ComponentTransform, const FVector& LocalLocation, float Alpha)
+{
+	FTransform StepTransform;
+	StepTransform.Blend(LastComponentTransform, ComponentTransform, Alpha);
+	return StepTransform.TransformPosition(FMath::Lerp(LastLocalLocation, LocalLocation, Alpha));
+}
+
+void MeleeTrace::BuildSubStepPath(const FTransform& LastComponentTransform, const FVector& LastLocalLocation,
+	const FTransform& ComponentTransform, const FVector& LocalLocation, int32 NumSubSteps, TArray<FVector>& OutPath)
+{
+	NumSubSteps = FMath::Max(NumSubSteps, 1);
+
+	OutPath.Reset(NumSubSteps + 1);
+	OutPath.Add(LastComponentTransform.TransformPosition(LastLocalLocation));
+
+	//! Only the frame samples are real poses, the sub-steps follow the owner's movement and turning between them
+	for (int32 Step = 1; Step <= NumSubSteps; Step++)
+	{
+		const float Alpha = static_cast<float>(Step) / NumSubSteps;
+		OutPath.Add(GetSubStepLocation(LastComponentTransform, LastLocalLocation, ComponentTransform, LocalLocation, Alpha));
+	}
+}
+
+UMeleeTraceComponent::UMeleeTraceComponent() :
+	TraceMesh{nullptr},
+	SubStepRate{120.f},
+	MaxSubStepsPerFrame{12},
+	TraceRadius{20.f},
+	TraceObjectType{ECollisionChannel::ECC_Pawn}
+{
+	PrimaryComponentTick.bCanEverTick = true;
+	//! Only ticks while a swing is active
+	PrimaryComponentTick.bStartWithTickEnabled = false;
+	//! Sockets are read after the animation of this frame is applied
+	PrimaryComponentTick.TickGroup = TG_PostUpdateWork;
+}
+
+void UMeleeTraceComponent::BeginPlay()
+{
+	Super::BeginPlay();
+
+	if (ACharacter* Character = Cast<ACharacter>(GetOwner()))
+	{
+		TraceMesh = Character->GetMesh();
+	}
+}
+
+void UMeleeTraceComponent::TickComponent(float DeltaTime, ELevelTick TickType, FActorComponentTickFunction* ThisTickFunction)
+{
+	Super::TickComponent(DeltaTime, TickType, ThisTickFunction);
+
+	SCOPE_CYCLE_COUNTER(STAT_MeleeTrace);
+
+	if (TraceMesh == nullptr || ActiveSwings.Num() == 0)
+	{
+		SetComponentTickEnabled(false);
+		return;
+	}
+
+	const int32 NumSubSteps = MeleeTrace::GetNumSubSteps(DeltaTime, SubStepRate, MaxSubStepsPerFrame);
+
+	for (FMeleeSwing& Swing : ActiveSwings)
+	{
+		TraceSwing(Swing, NumSubSteps);
+	}
+
+	for (const FPendingMeleeHit& PendingHit : PendingHits)
+	{
+		if (PendingHit.Victim.IsValid())
+		{
+			OnMeleeHit.Broadcast(PendingHit.Victim.Get(), PendingHit.SocketName, PendingHit.Hit);
+		}
+	}
+	PendingHits.Reset();
+}
+
+void UMeleeTraceComponent::BeginSwing(FName SocketName)
+{
+	if (TraceMesh == nullptr || SocketName.IsNone()) return;
+
+	FMeleeSwing* Swing = ActiveSwings.FindByPredicate([SocketName](const FMeleeSwing& Active) { return Active.SocketName == SocketName; });
+	if (Swing == nullptr)
+	{
+		Swing = &ActiveSwings.AddDefaulted_GetRef();
+		Swing->SocketName = SocketName;
+	}
+
+	Swing->HitActors.Reset();
+	Swing->LastLocalLocation = GetLocalSocketLocation(*Swing);
+	Swing->LastComponentTransform = TraceMesh->GetComponentTransform();
+
+	SetComponentTickEnabled(true);
+}
+
+void UMeleeTraceComponent::EndSwing(FName SocketName)
+{
+	ActiveSwings.RemoveAllSwap([SocketName](const FMeleeSwing& Active) { return Active.SocketName == SocketName; });
+
+	if (ActiveSwings.Num() == 0)
+	{
+		SetComponentTickEnabled(false);
+	}
+}
+
+void UMeleeTraceComponent::EndAllSwings()
+{
+	ActiveSwings.Empty();
+	SetComponentTickEnabled(false);
+}
+
+void UMeleeTraceComponent::TraceSwing(FMeleeSwing& Swing, int32 NumSubSteps)
+{
+	const FVector LocalLocation = GetLocalSocketLocation(Swing);
+	const FTransform ComponentTransform = TraceMesh->GetComponentTransform();
+
+	//! Owner and actors this swing already hit are left out of every sweep
+	FCollisionQueryParams QueryParams(SCENE_QUERY_STAT(MeleeTrace), false, GetOwner());
+	for (const TWeakObjectPtr<AActor>& HitActor : Swing.HitActors)
+	{
+		if (HitActor.IsValid())
+		{
+			QueryParams.AddIgnoredActor(HitActor.Get());
+		}
+	}
+
+	const FCollisionObjectQueryParams ObjectQueryParams(TraceObjectType);
+	const FCollisionShape Sphere = FCollisionShape::MakeSphere(TraceRadius);
+	TArray<FHitResult> Hits;
+
+	MeleeTrace::BuildSubStepPath(Swing.LastComponentTransform, Swing.LastLocalLocation, ComponentTransform, LocalLocation,
+		NumSubSteps, SubStepPath);
+
+	for (int32 Step = 1; Step < SubStepPath.Num(); Step++)
+	{
+		INC_DWORD_STAT(STAT_MeleeSweeps);
+		Hits.Reset();
+		GetWorld()->SweepMultiByObjectType(Hits, SubStepPath[Step - 1], SubStepPath[Step], FQuat::Identity, ObjectQueryParams,
+			Sphere, QueryParams);
+
+		for (const FHitResult& Hit : Hits)
+		{
+			AActor* Victim = Hit.GetActor();
+			if (Victim == nullptr || Swing.HitActors.Contains(Victim)) continue;
+
+			Swing.HitActors.Add(Victim);
+			QueryParams.AddIgnoredActor(Victim);
+
+			INC_DWORD_STAT(STAT_MeleeHits);
+			PendingHits.Add(FPendingMeleeHit{ Victim, Swing.SocketName, Hit });
+		}
+	}
+
+	Swing.LastLocalLocation = LocalLocation;
+	Swing.LastComponentTransform = ComponentTransform;
+}
+
+FVector UMeleeTraceComponent::GetLocalSocketLocation(FMeleeSwing& Swing)
+{
+	if (const USkeletalMeshSocket* Socket = Swing.Socket.Get(this, TraceMesh, Swing.SocketName))
+	{
+		return TraceMesh->GetComponentTransform().InverseTransformPosition(Socket->GetSocketLocation(TraceMesh));
+	}
+
+	const int32 BoneIndex = Swing.Bone.Get(this, TraceMesh, Swing.SocketName);
+	if (BoneIndex == INDEX_NONE) return FVector::ZeroVector;
+
+	return TraceMesh->GetBoneTransform(BoneIndex, FTransform::Identity).GetLocation();
+}
@@ -0,0 +1,173 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Components/ActorComponent.h"
+#include "UltimateShooter/Subsystems/SocketCacheSubsystem.h"
+#include "MeleeTraceComponent.generated.h"
+
+class USkeletalMeshComponent;
+
+DECLARE_MULTICAST_DELEGATE_ThreeParams(FOnMeleeHit, AActor* /*Victim*/, FName /*SocketName*/, const FHitResult& /*Hit*/);
+
+//! One weapon socket being traced between BeginSwing and EndSwing
+struct FMeleeSwing
+{
+	FName SocketName;
+
+	//! SocketName resolved on the traced mesh
+	FCachedSocket Socket;
+
+	//! SocketName resolved as a bone, for meshes where it is not a socket
+	FCachedBone Bone;
+
+	//! Socket location in component space at the last sample
+	FVector LastLocalLocation = FVector::ZeroVector;
+
+	//! Mesh transform at the last sample
+	FTransform LastComponentTransform = FTransform::Identity;
+
+	//! Actors already hit by this swing
+	TArray<TWeakObjectPtr<AActor>> HitActors;
+};
+
+//! Hit found by a sweep, reported after every swing is traced
+struct FPendingMeleeHit
+{
+	TWeakObjectPtr<AActor> Victim;
+	FName SocketName;
+	FHitResult Hit;
+};
+
+namespace MeleeTrace
+{
+	/**
+	 * @brief Number of sweeps a frame of DeltaTime seconds is split into
+	 * 
+	 * @param DeltaTime Length of the frame
+	 * @param SubStepRate Sub-steps per second
+	 * @param MaxSubSteps Upper limit of sub-steps in one frame
+	 * @return int32 At least 1 and at most MaxSubSteps
+	 */
+	ULTIMATESHOOTER_API int32 GetNumSubSteps(float DeltaTime, float SubStepRate, int32 MaxSubSteps);
+
+	/**
+	 * @brief World location of a socket Alpha of the way between the last and the current frame sample
+	 * 
+	 * The component space socket location is lerped and the mesh transform is blended on its own, so a socket held
+	 * still by a turning owner moves along an arc instead of cutting the chord.
+	 * 
+	 * @param LastComponentTransform Mesh transform at the last sample
+	 * @param LastLocalLocation Component space socket location at the last sample
+	 * @param ComponentTransform Mesh transform at the current sample
+	 * @param LocalLocation Component space socket location at the current sample
+	 * @param Alpha 0 is the last sample, 1 the current one
+	 */
+	ULTIMATESHOOTER_API FVector GetSubStepLocation(const FTransform& LastComponentTransform, const FVector& LastLocalLocation,
+		const FTransform& ComponentTransform, const FVector& LocalLocation, float Alpha);
+
+	/**
+	 * @brief Points the sweeps of one frame run through, from the last sample to the current one
+	 * 
+	 * @param NumSubSteps Number of sweeps the frame is split into
+	 * @param OutPath Replaced by NumSubSteps + 1 points, the first is the last sample and the last the current one
+	 * @see GetSubStepLocation()
+	 */
+	ULTIMATESHOOTER_API void BuildSubStepPath(const FTransform& LastComponentTransform, const FVector& LastLocalLocation,
+		const FTransform& ComponentTransform, const FVector& LocalLocation, int32 NumSubSteps, TArray<FVector>& OutPath);
+}
+
+/**
+ * @brief Detects melee hits by sweeping spheres along the path of weapon sockets.
+ * 
+ * While a swing is active, the socket is sampled once per frame and a sphere is swept from the last sample to the
+ * current one, so the swept path has no gaps between frames and a fast swing cannot skip over a target. The socket
+ * pose between two samples is not known: its component space location is interpolated in a straight line, and only
+ * the owner's movement and turning between the samples is followed, by splitting the sweep into sub-steps at
+ * SubStepRate. A swing that curves a lot within one frame is approximated by its chord, more so at low frame rates.
+ * Each actor is reported at most once per swing through OnMeleeHit.
+ */
+UCLASS(ClassGroup = (Custom), meta = (BlueprintSpawnableComponent))
+class ULTIMATESHOOTER_API UMeleeTraceComponent : public UActorComponent
+{
+	GENERATED_BODY()
+
+public:
+	UMeleeTraceComponent();
+
+	virtual void BeginPlay() override;
+
+	/**
+	 * @brief Sweeps the path of every active swing since the last frame
+	 * 
+	 * @param DeltaTime The time elapsed since the last frame.
+	 * @param TickType Kind of tick.
+	 * @param ThisTickFunction Tick function that called this.
+	 */
+	virtual void TickComponent(float DeltaTime, ELevelTick TickType, FActorComponentTickFunction* ThisTickFunction) override;
+
+	/**
+	 * @brief Starts tracing SocketName, actors hit by a previous swing of the socket can be hit again
+	 * 
+	 * @param SocketName Socket on the owner's mesh at the tip of the weapon
+	 */
+	void BeginSwing(FName SocketName);
+
+	/**
+	 * @brief Stops tracing SocketName
+	 * 
+	 */
+	void EndSwing(FName SocketName);
+
+	/**
+	 * @brief Stops tracing every socket
+	 * 
+	 */
+	void EndAllSwings();
+
+	//! Called once per actor per swing
+	FOnMeleeHit OnMeleeHit;
+
+private:
+	/**
+	 * @brief Sweeps Swing from its last sample to the current socket location in NumSubSteps segments
+	 * 
+	 * New hits are added to PendingHits.
+	 * 
+	 * @see MeleeTrace::BuildSubStepPath()
+	 */
+	void TraceSwing(FMeleeSwing& Swing, int32 NumSubSteps);
+
+	//! Gets the socket location of Swing in the space of TraceMesh, falling back to the bone of that name
+	FVector GetLocalSocketLocation(FMeleeSwing& Swing);
+
+	//! Mesh the weapon sockets are on, the owner's character mesh
+	UPROPERTY()
+	USkeletalMeshComponent* TraceMesh;
+
+	//! Swings being traced
+	TArray<FMeleeSwing> ActiveSwings;
+
+	//! Hits of this frame, broadcast once tracing is done since handlers may end swings
+	TArray<FPendingMeleeHit> PendingHits;
+
+	//! Sweep path of the swing being traced, kept to reuse its allocation
+	TArray<FVector> SubStepPath;
+
+	//! Sub-steps per second the sweep between two frame samples is split into, to follow the owner's movement and turning
+	UPROPERTY(EditAnywhere, Category = "Melee Trace", meta = (AllowPrivateAccess = "true", ClampMin = "1.0"))
+	float SubStepRate;
+
+	//! Upper limit of sub-steps in one frame, so a hitch does not cause a burst of sweeps
+	UPROPERTY(EditAnywhere, Category = "Melee Trace", meta = (AllowPrivateAccess = "true", ClampMin = "1"))
+	int32 MaxSubStepsPerFrame;
+
+	//! Radius of the swept sphere
+	UPROPERTY(EditAnywhere, Category = "Melee Trace", meta = (AllowPrivateAccess = "true"))
+	float TraceRadius;
+
+	//! Object type the sweeps look for, every object of the type in the path is reported
+	UPROPERTY(EditAnywhere, Category = "Melee Trace", meta = (AllowPrivateAccess = "true"))
+	TEnumAsByte<ECollisionChannel> TraceObjectType;
+};
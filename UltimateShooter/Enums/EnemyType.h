@@ -0,0 +1,12 @@
+#pragma once
+
+UENUM(BlueprintType)
+enum class EEnemyType : uint8
+{
+	EET_Grux UMETA(DisplayName = "Grux"),
+	EET_Minion UMETA(DisplayName = "Minion"),
+	EET_Khaimera UMETA(DisplayName = "Khaimera"),
+	EET_Other UMETA(DisplayName = "Other"),
+
+	EET_MAX UMETA(DisplayName = "DefaultMAX")
+};
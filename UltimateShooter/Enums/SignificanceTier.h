@@ -0,0 +1,12 @@
+#pragma once
+
+UENUM(BlueprintType)
+enum class ESignificanceTier : uint8
+{
+	EST_High UMETA(DisplayName = "High"),
+	EST_Medium UMETA(DisplayName = "Medium"),
+	EST_Low UMETA(DisplayName = "Low"),
+	EST_Dormant UMETA(DisplayName = "Dormant"),
+
+	EST_MAX UMETA(DisplayName = "DefaultMAX")
+};
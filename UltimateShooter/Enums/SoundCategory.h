@@ -0,0 +1,12 @@
+#pragma once
+
+UENUM(BlueprintType)
+enum class ESoundCategory : uint8
+{
+	ESC_WeaponFire UMETA(DisplayName = "WeaponFire"),
+	ESC_Impact UMETA(DisplayName = "Impact"),
+	ESC_Melee UMETA(DisplayName = "Melee"),
+	ESC_Explosion UMETA(DisplayName = "Explosion"),
+
+	ESC_MAX UMETA(DisplayName = "DefaultMAX")
+};
@@ -5,6 +5,8 @@
 #include "Kismet/GameplayStatics.h"
 #include "Sound/SoundCue.h"
 #include "Particles/ParticleSystemComponent.h"
+#include "UltimateShooter/Subsystems/FXBudgetSubsystem.h"
+#include "UltimateShooter/Subsystems/SoundDispatchSubsystem.h"
 
 // Sets default values
 ABreakableWall::ABreakableWall()
@@ -37,12 +39,12 @@ void ABreakableWall::BulletHit_Implementation(FHitResult HitResult, AActor* Shoo
 	{
 		FTransform SocketTransform = Mesh->GetSocketTransform(FName("ExplosionSocket"));
 		SocketTransform.SetScale3D(FVector(1.f));
-		UGameplayStatics::SpawnEmitterAtLocation(GetWorld(), ImpactParticles, SocketTransform);
+		UFXBudgetSubsystem::SpawnEmitterAtLocation(this, ImpactParticles, SocketTransform);
 	}
 
 	if (ImpactSound)
 	{
-		UGameplayStatics::PlaySoundAtLocation(this, ImpactSound, GetActorLocation());
+		USoundDispatchSubsystem::PlaySoundAtLocation(this, ImpactSound, GetActorLocation(), ESoundCategory::ESC_Impact);
 	}
 
 	Destroy();
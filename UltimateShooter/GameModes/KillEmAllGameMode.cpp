@@ -2,13 +2,15 @@
 
 
 #include "KillEmAllGameMode.h"
-#include "EngineUtils.h"
+#include "Engine/World.h"
 #include "GameFramework/Controller.h"
-#include "UltimateShooter/Characters/EnemyController.h"
 #include "GameFramework/Character.h"
 #include "Kismet/GameplayStatics.h"
 #include "Sound/SoundCue.h"
 #include "Components/AudioComponent.h"
+#include "UltimateShooter/UltimateShooter.h"
+
+DECLARE_CYCLE_STAT(TEXT("Character Killed"), STAT_CharacterKilled, STATGROUP_UltimateShooter);
 
 void AKillEmAllGameMode::BeginPlay()
 {
@@ -29,32 +31,37 @@ void AKillEmAllGameMode::CharacterKilled(ACharacter* Character)
 {
     Super::CharacterKilled(Character);
 
+    SCOPE_CYCLE_COUNTER(STAT_CharacterKilled);
+
     APlayerController* PlayerController = Cast<APlayerController>(Character->GetController());
     if (PlayerController)
     {
         EndGame(false);
+        return;
     }
 
-    for (AEnemyController* Controller : TActorRange<AEnemyController>(GetWorld()))
+    //! Dying enemies unregister themselves before reporting the kill
+    if (GetLiveEnemyCount() == 0)
     {
-        if (!Controller->IsDead())
-        {
-            return;
-        }
+        EndGame(true);
     }
-
-    EndGame(true);
 }
 
 void AKillEmAllGameMode::EndGame(bool bIsPlayerWinner)
 {
+    bGameEnded = true;
+    bPlayerWon = bIsPlayerWinner;
+
     if (MusicComponent && MusicComponent->IsPlaying())
     {
         MusicComponent->Stop();
     }
 
-    for (AController* Controller : TActorRange<AController>(GetWorld())) 
+    for (FConstControllerIterator It = GetWorld()->GetControllerIterator(); It; ++It)
     {
+        AController* Controller = It->Get();
+        if (Controller == nullptr) continue;
+
         if (Controller->IsPlayerController())
         {
             Controller->GameHasEnded(Controller->GetPawn(),bIsPlayerWinner);
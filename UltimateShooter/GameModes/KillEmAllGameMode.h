@@ -34,6 +34,10 @@ private:
 	UPROPERTY()
 	class UAudioComponent* MusicComponent;
 
+	//! Set by EndGame
+	bool bGameEnded{ false };
+	bool bPlayerWon{ false };
+
 protected:
 	/**
 	 * @brief Called when the game starts or the character is spawned.
@@ -47,11 +51,14 @@ public:
 	 * @brief Called when any character dies during the game.
 	 * 
 	 * If the killed character is controlled by a player, the game ends in defeat.
-	 * Otherwise, checks if all enemy AI are dead — if so, ends the game in victory.
+	 * Otherwise, checks the live-enemy registry — if it is empty, ends the game in victory.
 	 * 
 	 * @param Character The character that has been killed.
 	 * 
 	 * @see EndGame()
 	 */
 	virtual void CharacterKilled(ACharacter* Character);
+
+	FORCEINLINE bool HasGameEnded() const { return bGameEnded; }
+	FORCEINLINE bool IsPlayerWinner() const { return bPlayerWon; }
 };
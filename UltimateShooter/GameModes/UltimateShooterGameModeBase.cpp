@@ -2,8 +2,47 @@
 
 
 #include "UltimateShooterGameModeBase.h"
+#include "UltimateShooter/Characters/Enemy.h"
+#include "UltimateShooter/UltimateShooter.h"
+
+DECLARE_DWORD_ACCUMULATOR_STAT(TEXT("Live Enemies"), STAT_LiveEnemies, STATGROUP_UltimateShooter);
 
 void AUltimateShooterGameModeBase::CharacterKilled(ACharacter* Character)
 {
 
-}
\ No newline at end of file
+}
+
+void AUltimateShooterGameModeBase::RegisterEnemy(AEnemy* Enemy)
+{
+	if (Enemy == nullptr || Enemy->IsDead()) return;
+
+	if (LiveEnemies.Contains(Enemy)) return;
+
+	//! Enemies are possessed before BeginPlay, this may be the first time the archetype is needed
+	const EEnemyType EnemyType = Enemy->GetArchetypeEnemyType();
+	LiveEnemies.Add(Enemy, EnemyType);
+	LiveEnemyCountByType.FindOrAdd(EnemyType)++;
+	INC_DWORD_STAT(STAT_LiveEnemies);
+}
+
+void AUltimateShooterGameModeBase::UnregisterEnemy(AEnemy* Enemy)
+{
+	EEnemyType EnemyType;
+	if (!LiveEnemies.RemoveAndCopyValue(Enemy, EnemyType)) return;
+
+	//! Counted under the type it was registered with
+	if (int32* Count = LiveEnemyCountByType.Find(EnemyType))
+	{
+		if (--(*Count) <= 0)
+		{
+			LiveEnemyCountByType.Remove(EnemyType);
+		}
+	}
+	DEC_DWORD_STAT(STAT_LiveEnemies);
+}
+
+int32 AUltimateShooterGameModeBase::GetLiveEnemyCountByType(EEnemyType EnemyType) const
+{
+	const int32* Count = LiveEnemyCountByType.Find(EnemyType);
+	return Count ? *Count : 0;
+}
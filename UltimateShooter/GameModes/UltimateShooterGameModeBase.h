@@ -4,6 +4,7 @@
 
 #include "CoreMinimal.h"
 #include "GameFramework/GameModeBase.h"
+#include "UltimateShooter/Enums/EnemyType.h"
 #include "UltimateShooterGameModeBase.generated.h"
 
 /**
@@ -24,5 +25,43 @@ public:
 	 * @param Character The character that has been killed.
 	 */
 	virtual void CharacterKilled(ACharacter* Character);
-	
+
+	/**
+	 * @brief Adds an enemy to the live-enemy registry
+	 * 
+	 * Called by AEnemyController when it possesses an enemy. Registering the
+	 * same enemy twice has no effect.
+	 * 
+	 * @param Enemy Enemy that just came under AI control
+	 */
+	virtual void RegisterEnemy(class AEnemy* Enemy);
+
+	/**
+	 * @brief Removes an enemy from the live-enemy registry
+	 * 
+	 * Called when an enemy dies or is unpossessed. Unregistering an enemy that
+	 * is not in the registry has no effect.
+	 * 
+	 * @param Enemy Enemy that is no longer alive
+	 */
+	virtual void UnregisterEnemy(AEnemy* Enemy);
+
+	/**
+	 * @brief Number of live enemies of the given type
+	 * 
+	 * @param EnemyType Type of the enemy archetype
+	 * @return int32 Live enemies of that type
+	 */
+	int32 GetLiveEnemyCountByType(EEnemyType EnemyType) const;
+
+private:
+	//! Enemies currently alive and under AI control, with the archetype type they were counted under
+	UPROPERTY()
+	TMap<AEnemy*, EEnemyType> LiveEnemies;
+
+	//! Live enemy counts keyed by the archetype type of the enemies
+	TMap<EEnemyType, int32> LiveEnemyCountByType;
+
+public:
+	FORCEINLINE int32 GetLiveEnemyCount() const { return LiveEnemies.Num(); }
 };
@@ -0,0 +1,163 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+
+#include "DamagePipelineSubsystem.h"
+#include "Engine/World.h"
+#include "Kismet/GameplayStatics.h"
+#include "GameFramework/DamageType.h"
+#include "UltimateShooter/Characters/Enemy.h"
+#include "UltimateShooter/UltimateShooter.h"
+
+DECLARE_CYCLE_STAT(TEXT("Resolve Damage"), STAT_ResolveDamage, STATGROUP_UltimateShooter);
+DECLARE_DWORD_COUNTER_STAT(TEXT("Damage Requests Queued"), STAT_DamageRequestsQueued, STATGROUP_UltimateShooter);
+DECLARE_DWORD_COUNTER_STAT(TEXT("Damage Requests Applied"), STAT_DamageRequestsApplied, STATGROUP_UltimateShooter);
+DECLARE_DWORD_COUNTER_STAT(TEXT("Damage Requests Merged"), STAT_DamageRequestsMerged, STATGROUP_UltimateShooter);
+DECLARE_DWORD_COUNTER_STAT(TEXT("Damage Requests Dropped"), STAT_DamageRequestsDropped, STATGROUP_UltimateShooter);
+DECLARE_FLOAT_COUNTER_STAT(TEXT("Damage Per Frame"), STAT_DamagePerFrame, STATGROUP_UltimateShooter);
+
+int32 DamagePipeline::SortAndMerge(TArray<FDamageRequest>& Requests)
+{
+	Requests.StableSort([](const FDamageRequest& A, const FDamageRequest& B) { return A.TargetId < B.TargetId; });
+
+	int32 NumKept{ 0 };
+	for (int32 i = 0; i < Requests.Num();)
+	{
+		FDamageRequest Merged = MoveTemp(Requests[i++]);
+
+		while (i < Requests.Num() && Requests[i].TargetId == Merged.TargetId &&
+			Requests[i].InstigatorId == Merged.InstigatorId && Requests[i].CauserId == Merged.CauserId)
+		{
+			FDamageRequest& Next = Requests[i++];
+			Merged.Amount += Next.Amount;
+			if (Next.bShowHitNumber)
+			{
+				Merged.HitLocation = Next.HitLocation;
+				Merged.bHeadShot |= Next.bHeadShot;
+				Merged.bShowHitNumber = true;
+			}
+			if (Next.OnApplied)
+			{
+				Merged.OnApplied = Merged.OnApplied ?
+					[First = MoveTemp(Merged.OnApplied), Second = MoveTemp(Next.OnApplied)]() { First(); Second(); } :
+					MoveTemp(Next.OnApplied);
+			}
+		}
+
+		//! Merged requests are written over the ones they replaced, NumKept never passes i
+		Requests[NumKept++] = MoveTemp(Merged);
+	}
+
+	const int32 NumMerged = Requests.Num() - NumKept;
+	Requests.SetNum(NumKept, false);
+	return NumMerged;
+}
+
+void UDamagePipelineSubsystem::Tick(float DeltaTime)
+{
+	Super::Tick(DeltaTime);
+
+	if (PendingDamage.Num() == 0) return;
+
+	SCOPE_CYCLE_COUNTER(STAT_ResolveDamage);
+
+	//! Damage queued while resolving, by a death for example, waits for the next frame
+	TArray<FDamageRequest> Requests = MoveTemp(PendingDamage);
+	PendingDamage.Reset();
+
+	const int32 NumMerged = DamagePipeline::SortAndMerge(Requests);
+	INC_DWORD_STAT_BY(STAT_DamageRequestsMerged, NumMerged);
+
+	for (const FDamageRequest& Request : Requests)
+	{
+		if (ApplyRequest(Request))
+		{
+			INC_DWORD_STAT(STAT_DamageRequestsApplied);
+			INC_FLOAT_STAT_BY(STAT_DamagePerFrame, Request.Amount);
+		}
+		else
+		{
+			INC_DWORD_STAT(STAT_DamageRequestsDropped);
+		}
+	}
+}
+
+TStatId UDamagePipelineSubsystem::GetStatId() const
+{
+	RETURN_QUICK_DECLARE_CYCLE_STAT(UDamagePipelineSubsystem, STATGROUP_Tickables);
+}
+
+void UDamagePipelineSubsystem::QueueDamage(const UObject* WorldContextObject, AActor* Target, float Amount,
+	AController* Instigator, AActor* Causer, TFunction<void()> OnApplied)
+{
+	FDamageRequest Request;
+	Request.Target = Target;
+	Request.Amount = Amount;
+	Request.Instigator = Instigator;
+	Request.Causer = Causer;
+	Request.OnApplied = MoveTemp(OnApplied);
+	Enqueue(WorldContextObject, Request);
+}
+
+void UDamagePipelineSubsystem::QueueHitDamage(const UObject* WorldContextObject, AActor* Target, float Amount,
+	AController* Instigator, AActor* Causer, const FVector& HitLocation, bool bHeadShot)
+{
+	FDamageRequest Request;
+	Request.Target = Target;
+	Request.Amount = Amount;
+	Request.Instigator = Instigator;
+	Request.Causer = Causer;
+	Request.HitLocation = HitLocation;
+	Request.bHeadShot = bHeadShot;
+	Request.bShowHitNumber = true;
+	Enqueue(WorldContextObject, Request);
+}
+
+UDamagePipelineSubsystem* UDamagePipelineSubsystem::Get(const UObject* WorldContextObject)
+{
+	UWorld* World = WorldContextObject ? WorldContextObject->GetWorld() : nullptr;
+	if (World == nullptr) return nullptr;
+
+	return World->GetSubsystem<UDamagePipelineSubsystem>();
+}
+
+void UDamagePipelineSubsystem::Enqueue(const UObject* WorldContextObject, FDamageRequest& Request)
+{
+	AActor* Target = Request.Target.Get();
+	if (Target == nullptr || Request.Amount == 0.f) return;
+
+	Request.TargetId = Target->GetUniqueID();
+	Request.InstigatorId = Request.Instigator.IsValid() ? Request.Instigator->GetUniqueID() : 0;
+	Request.CauserId = Request.Causer.IsValid() ? Request.Causer->GetUniqueID() : 0;
+
+	UDamagePipelineSubsystem* DamagePipeline = Get(WorldContextObject);
+	if (DamagePipeline == nullptr)
+	{
+		ApplyRequest(Request);
+		return;
+	}
+
+	INC_DWORD_STAT(STAT_DamageRequestsQueued);
+	DamagePipeline->PendingDamage.Add(MoveTemp(Request));
+}
+
+bool UDamagePipelineSubsystem::ApplyRequest(const FDamageRequest& Request)
+{
+	AActor* Target = Request.Target.Get();
+	if (!IsValid(Target)) return false;
+
+	AEnemy* Enemy = Cast<AEnemy>(Target);
+	if (Enemy && Enemy->IsDead()) return false;
+
+	if (Enemy && Request.bShowHitNumber)
+	{
+		Enemy->SpawnHitNumber(FMath::RoundToInt(Request.Amount), Request.HitLocation, Request.bHeadShot);
+	}
+
+	UGameplayStatics::ApplyDamage(Target, Request.Amount, Request.Instigator.Get(), Request.Causer.Get(), UDamageType::StaticClass());
+
+	if (Request.OnApplied)
+	{
+		Request.OnApplied();
+	}
+	return true;
+}
@@ -0,0 +1,125 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Subsystems/WorldSubsystem.h"
+#include "DamagePipelineSubsystem.generated.h"
+
+//! Damage queued this frame, applied when the frame's damage is resolved
+struct FDamageRequest
+{
+	TWeakObjectPtr<AActor> Target;
+
+	//! Unique ID of Target, requests are sorted by it
+	uint32 TargetId = 0;
+
+	float Amount = 0.f;
+
+	TWeakObjectPtr<AController> Instigator;
+
+	TWeakObjectPtr<AActor> Causer;
+
+	//! Unique IDs of Instigator and Causer, 0 if there is none, requests are merged by them
+	uint32 InstigatorId = 0;
+	uint32 CauserId = 0;
+
+	//! Where a Hit Number is shown, only used when bShowHitNumber is true
+	FVector HitLocation = FVector::ZeroVector;
+
+	bool bHeadShot = false;
+
+	//! true to show a Hit Number on an enemy target
+	bool bShowHitNumber = false;
+
+	//! Runs right after the damage is applied, not if the request is dropped
+	TFunction<void()> OnApplied;
+};
+
+namespace DamagePipeline
+{
+	/**
+	 * @brief Sorts Requests by target and merges consecutive requests to the same target from the same instigator and causer
+	 * 
+	 * The sort is stable, so each target keeps its requests in the order they were queued in and the request that
+	 * kills a target is still the one credited with the kill. Merged requests add up their Amount and keep the Hit
+	 * Number of the last request that shows one, their OnApplied callbacks run in queue order.
+	 * 
+	 * @param Requests Requests in the order they were queued in, replaced by the merged requests
+	 * @return int32 Number of requests merged into another one
+	 */
+	ULTIMATESHOOTER_API int32 SortAndMerge(TArray<FDamageRequest>& Requests);
+}
+
+/**
+ * @brief Collects the damage of a frame and applies it in one pass at the end of the frame.
+ * 
+ * Requests are sorted by target, keeping the order they were queued in for each target, so the request that kills a
+ * target is the one credited with the kill. Consecutive requests to the same target from the same instigator and
+ * causer are merged into one ApplyDamage call and one Hit Number, so multi-hit frames run TakeDamage, the blackboard
+ * writes and the hit FX once. Requests to enemies that are already dying are dropped.
+ */
+UCLASS()
+class ULTIMATESHOOTER_API UDamagePipelineSubsystem : public UTickableWorldSubsystem
+{
+	GENERATED_BODY()
+
+public:
+	/**
+	 * @brief Resolves the damage queued this frame
+	 * 
+	 * @param DeltaTime The time elapsed since the last frame.
+	 */
+	virtual void Tick(float DeltaTime) override;
+
+	virtual TStatId GetStatId() const override;
+
+	/**
+	 * @brief Queued replacement for UGameplayStatics::ApplyDamage
+	 * 
+	 * Applies the damage right away if the world has no damage pipeline.
+	 * 
+	 * @param WorldContextObject Object used to find the world
+	 * @param Target Actor that takes the damage
+	 * @param Amount Damage amount
+	 * @param Instigator Controller responsible for the damage
+	 * @param Causer Actor that caused the damage
+	 * @param OnApplied Runs right after the damage is applied, for effects that must see the target's new health
+	 */
+	static void QueueDamage(const UObject* WorldContextObject, AActor* Target, float Amount, AController* Instigator,
+		AActor* Causer, TFunction<void()> OnApplied = nullptr);
+
+	/**
+	 * @brief Queues damage from a hit that shows a Hit Number on an enemy target
+	 * 
+	 * @param HitLocation Where the Hit Number is shown
+	 * @param bHeadShot Determines the color of the Hit Number
+	 * @see QueueDamage()
+	 */
+	static void QueueHitDamage(const UObject* WorldContextObject, AActor* Target, float Amount, AController* Instigator,
+		AActor* Causer, const FVector& HitLocation, bool bHeadShot);
+
+	/**
+	 * @brief Gets the damage pipeline of the world WorldContextObject is in
+	 * 
+	 * @return UDamagePipelineSubsystem* Subsystem, or nullptr if there is no world
+	 */
+	static UDamagePipelineSubsystem* Get(const UObject* WorldContextObject);
+
+private:
+	/**
+	 * @brief Queues Request, or applies it right away if there is no damage pipeline
+	 * 
+	 */
+	static void Enqueue(const UObject* WorldContextObject, FDamageRequest& Request);
+
+	/**
+	 * @brief Shows the Hit Number, applies the damage of Request and runs its OnApplied callback
+	 * 
+	 * @return true if the damage was applied, false if the target is gone or already dying
+	 */
+	static bool ApplyRequest(const FDamageRequest& Request);
+
+	//! Damage queued this frame
+	TArray<FDamageRequest> PendingDamage;
+};
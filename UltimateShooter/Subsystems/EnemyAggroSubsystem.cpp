@@ -0,0 +1,214 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+
+#include "EnemyAggroSubsystem.h"
+#include "Algo/BinarySearch.h"
+#include "Engine/World.h"
+#include "GameFramework/PlayerController.h"
+#include "Components/CapsuleComponent.h"
+#include "UltimateShooter/Characters/Enemy.h"
+#include "UltimateShooter/Characters/ShooterCharacter.h"
+#include "UltimateShooter/UltimateShooter.h"
+
+DECLARE_CYCLE_STAT(TEXT("Enemy Aggro Query"), STAT_EnemyAggroQuery, STATGROUP_UltimateShooter);
+DECLARE_DWORD_ACCUMULATOR_STAT(TEXT("Aggro Hash Cells"), STAT_AggroHashCells, STATGROUP_UltimateShooter);
+DECLARE_DWORD_COUNTER_STAT(TEXT("Aggro Distance Checks"), STAT_AggroDistanceChecks, STATGROUP_UltimateShooter);
+
+UEnemyAggroSubsystem::UEnemyAggroSubsystem() :
+	QueryInterval{0.1f},
+	TimeSinceQuery{0.f},
+	MinCellSize{500.f},
+	CellSize{500.f}
+{
+}
+
+void UEnemyAggroSubsystem::Tick(float DeltaTime)
+{
+	Super::Tick(DeltaTime);
+
+	TimeSinceQuery += DeltaTime;
+	if (TimeSinceQuery < QueryInterval) return;
+	TimeSinceQuery = 0.f;
+
+	SCOPE_CYCLE_COUNTER(STAT_EnemyAggroQuery);
+
+	TArray<AShooterCharacter*, TInlineAllocator<4>> Characters;
+	float MaxCharacterRadius{ 0.f };
+	for (FConstPlayerControllerIterator It = GetWorld()->GetPlayerControllerIterator(); It; ++It)
+	{
+		APlayerController* PlayerController = It->Get();
+		if (PlayerController == nullptr) continue;
+
+		if (AShooterCharacter* Character = Cast<AShooterCharacter>(PlayerController->GetPawn()))
+		{
+			Characters.Add(Character);
+			MaxCharacterRadius = FMath::Max(MaxCharacterRadius, Character->GetCapsuleComponent()->GetScaledCapsuleRadius());
+		}
+	}
+
+	BuildSpatialHash(MaxCharacterRadius);
+
+	for (AShooterCharacter* Character : Characters)
+	{
+		QueryCharacter(Character);
+	}
+
+	DispatchRangeChanges();
+}
+
+TStatId UEnemyAggroSubsystem::GetStatId() const
+{
+	RETURN_QUICK_DECLARE_CYCLE_STAT(UEnemyAggroSubsystem, STATGROUP_Tickables);
+}
+
+void UEnemyAggroSubsystem::RegisterEnemy(AEnemy* Enemy)
+{
+	if (Enemy == nullptr) return;
+
+	for (const FAggroEntry& Entry : Entries)
+	{
+		if (Entry.Enemy.Get() == Enemy) return;
+	}
+
+	FAggroEntry& Entry = Entries.AddDefaulted_GetRef();
+	Entry.Enemy = Enemy;
+}
+
+void UEnemyAggroSubsystem::UnregisterEnemy(AEnemy* Enemy)
+{
+	if (Enemy == nullptr) return;
+
+	//! Entries are only removed in BuildSpatialHash so CellEntries stay valid while range changes are dispatched
+	for (FAggroEntry& Entry : Entries)
+	{
+		if (Entry.Enemy.Get() == Enemy)
+		{
+			Entry.Enemy = nullptr;
+			return;
+		}
+	}
+}
+
+UEnemyAggroSubsystem* UEnemyAggroSubsystem::Get(const UObject* WorldContextObject)
+{
+	UWorld* World = WorldContextObject ? WorldContextObject->GetWorld() : nullptr;
+	if (World == nullptr) return nullptr;
+
+	return World->GetSubsystem<UEnemyAggroSubsystem>();
+}
+
+void UEnemyAggroSubsystem::BuildSpatialHash(float CharacterRadius)
+{
+	Entries.RemoveAllSwap([](const FAggroEntry& Entry) { return !Entry.Enemy.IsValid(); });
+
+	float MaxAgroRadius = MinCellSize;
+	for (const FAggroEntry& Entry : Entries)
+	{
+		MaxAgroRadius = FMath::Max(MaxAgroRadius, Entry.Enemy->GetAgroRadius());
+	}
+	CellSize = MaxAgroRadius + CharacterRadius;
+
+	//! Reset keeps the allocation, the array only grows when more enemies are registered
+	CellEntries.Reset();
+	for (int32 i = 0; i < Entries.Num(); i++)
+	{
+		FAggroEntry& Entry = Entries[i];
+		Entry.PassAgroCharacter = nullptr;
+		Entry.PassCombatCharacter = nullptr;
+
+		CellEntries.Add(FAggroCellEntry{ GetCellKey(GetCell(Entry.Enemy->GetActorLocation())), i });
+	}
+	CellEntries.Sort([](const FAggroCellEntry& A, const FAggroCellEntry& B) { return A.CellKey < B.CellKey; });
+
+#if STATS
+	int32 NumCells{ 0 };
+	for (int32 i = 0; i < CellEntries.Num(); i++)
+	{
+		if (i == 0 || CellEntries[i].CellKey != CellEntries[i - 1].CellKey) NumCells++;
+	}
+	SET_DWORD_STAT(STAT_AggroHashCells, NumCells);
+#endif
+}
+
+void UEnemyAggroSubsystem::QueryCharacter(AShooterCharacter* Character)
+{
+	const FVector CharacterLocation = Character->GetActorLocation();
+	const FIntPoint CharacterCell = GetCell(CharacterLocation);
+
+	//! The spheres used to fire as soon as they touched the capsule, not when they reached its center
+	const float CharacterRadius = Character->GetCapsuleComponent()->GetScaledCapsuleRadius();
+
+	//! CellSize is the largest AgroRadius plus the character radius, so every enemy that can reach the character is in
+	//! the surrounding 3x3 cells
+	for (int32 Y = -1; Y <= 1; Y++)
+	{
+		for (int32 X = -1; X <= 1; X++)
+		{
+			const uint64 CellKey = GetCellKey(CharacterCell + FIntPoint(X, Y));
+			for (int32 i = Algo::LowerBoundBy(CellEntries, CellKey, &FAggroCellEntry::CellKey);
+				i < CellEntries.Num() && CellEntries[i].CellKey == CellKey; i++)
+			{
+				FAggroEntry& Entry = Entries[CellEntries[i].EntryIndex];
+				AEnemy* Enemy = Entry.Enemy.Get();
+				if (Enemy == nullptr) continue;
+
+				INC_DWORD_STAT(STAT_AggroDistanceChecks);
+				const float DistanceSquared = FVector::DistSquared(Enemy->GetActorLocation(), CharacterLocation);
+
+				if (Entry.PassAgroCharacter == nullptr && DistanceSquared <= FMath::Square(Enemy->GetAgroRadius() + CharacterRadius))
+				{
+					Entry.PassAgroCharacter = Character;
+				}
+				if (Entry.PassCombatCharacter == nullptr && DistanceSquared <= FMath::Square(Enemy->GetCombatRangeRadius() + CharacterRadius))
+				{
+					Entry.PassCombatCharacter = Character;
+				}
+			}
+		}
+	}
+}
+
+void UEnemyAggroSubsystem::DispatchRangeChanges()
+{
+	for (FAggroEntry& Entry : Entries)
+	{
+		AEnemy* Enemy = Entry.Enemy.Get();
+		if (Enemy == nullptr) continue;
+
+		const ESignificanceTier Tier = Enemy->GetSignificanceTier();
+
+		//! Dormant enemies do not notice players, their last state is kept until they are checked again
+		if (Tier != ESignificanceTier::EST_Dormant)
+		{
+			if (Entry.PassAgroCharacter && !Entry.AgroCharacter.IsValid())
+			{
+				Enemy->AgroRangeEntered(Entry.PassAgroCharacter);
+			}
+			Entry.AgroCharacter = Entry.PassAgroCharacter;
+		}
+
+		//! Combat range only matters up close, enemies in combat are never below Medium
+		if (Tier <= ESignificanceTier::EST_Medium)
+		{
+			if (Entry.PassCombatCharacter && !Entry.CombatCharacter.IsValid())
+			{
+				Enemy->CombatRangeEntered(Entry.PassCombatCharacter);
+			}
+			else if (Entry.PassCombatCharacter == nullptr && Entry.CombatCharacter.IsValid())
+			{
+				Enemy->CombatRangeExited(Entry.CombatCharacter.Get());
+			}
+			Entry.CombatCharacter = Entry.PassCombatCharacter;
+		}
+	}
+}
+
+FIntPoint UEnemyAggroSubsystem::GetCell(const FVector& Location) const
+{
+	return FIntPoint(FMath::FloorToInt(Location.X / CellSize), FMath::FloorToInt(Location.Y / CellSize));
+}
+
+uint64 UEnemyAggroSubsystem::GetCellKey(const FIntPoint& Cell)
+{
+	return (static_cast<uint64>(static_cast<uint32>(Cell.Y)) << 32) | static_cast<uint32>(Cell.X);
+}
@@ -0,0 +1,124 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Subsystems/WorldSubsystem.h"
+#include "EnemyAggroSubsystem.generated.h"
+
+class AEnemy;
+class AShooterCharacter;
+
+//! Range state of one registered enemy
+struct FAggroEntry
+{
+	TWeakObjectPtr<AEnemy> Enemy;
+
+	//! Player in range after the last query pass
+	TWeakObjectPtr<AShooterCharacter> AgroCharacter;
+	TWeakObjectPtr<AShooterCharacter> CombatCharacter;
+
+	//! Player found in range during the current query pass
+	AShooterCharacter* PassAgroCharacter = nullptr;
+	AShooterCharacter* PassCombatCharacter = nullptr;
+};
+
+//! Entry of the spatial hash, an enemy and the key of the cell it stands in
+struct FAggroCellEntry
+{
+	uint64 CellKey;
+
+	//! Index into the registered enemies
+	int32 EntryIndex;
+};
+
+/**
+ * @brief Detects players entering enemy aggro and combat range without overlap components.
+ * 
+ * Every QueryInterval seconds all registered enemies are put into a uniform 2D spatial hash, and each player character
+ * only checks the enemies in the cells around it. Range changes are handed to AEnemy::AgroRangeEntered,
+ * AEnemy::CombatRangeEntered and AEnemy::CombatRangeExited, which write the same blackboard keys the overlap events did.
+ */
+UCLASS()
+class ULTIMATESHOOTER_API UEnemyAggroSubsystem : public UTickableWorldSubsystem
+{
+	GENERATED_BODY()
+
+public:
+	UEnemyAggroSubsystem();
+
+	/**
+	 * @brief Runs a query pass once QueryInterval has passed
+	 * 
+	 * @param DeltaTime The time elapsed since the last frame.
+	 */
+	virtual void Tick(float DeltaTime) override;
+
+	virtual TStatId GetStatId() const override;
+
+	/**
+	 * @brief Starts range checks for the enemy
+	 * 
+	 * @param Enemy Enemy that started play
+	 */
+	void RegisterEnemy(AEnemy* Enemy);
+
+	/**
+	 * @brief Stops range checks for the enemy, its entry is removed on the next query pass
+	 * 
+	 * @param Enemy Enemy that died or left play
+	 */
+	void UnregisterEnemy(AEnemy* Enemy);
+
+	/**
+	 * @brief Gets the aggro subsystem of the world WorldContextObject is in
+	 * 
+	 * @return UEnemyAggroSubsystem* Subsystem, or nullptr if there is no world
+	 */
+	static UEnemyAggroSubsystem* Get(const UObject* WorldContextObject);
+
+private:
+	/**
+	 * @brief Removes unregistered entries and puts the rest into CellEntries by their current location
+	 * 
+	 * CellEntries is refilled and sorted in place, so rebuilding does not allocate once it has grown to the enemy count.
+	 * 
+	 * @param CharacterRadius Largest capsule radius of the queried characters, added to the cell size
+	 */
+	void BuildSpatialHash(float CharacterRadius);
+
+	/**
+	 * @brief Marks every enemy in the cells around the character whose aggro or combat range touches its capsule
+	 * 
+	 * @param Character Player character to check against
+	 */
+	void QueryCharacter(AShooterCharacter* Character);
+
+	/**
+	 * @brief Compares the result of the pass with the previous one and notifies enemies whose range state changed
+	 * 
+	 */
+	void DispatchRangeChanges();
+
+	FIntPoint GetCell(const FVector& Location) const;
+
+	//! Packs a cell into the key CellEntries is sorted by
+	static uint64 GetCellKey(const FIntPoint& Cell);
+
+	//! Registered enemies, CellEntries index into this array
+	TArray<FAggroEntry> Entries;
+
+	//! Spatial hash of Entries indices sorted by cell key, the enemies of a cell are next to each other, rebuilt every pass
+	TArray<FAggroCellEntry> CellEntries;
+
+	//! Seconds between two query passes
+	float QueryInterval;
+
+	float TimeSinceQuery;
+
+	//! Cells are never smaller than this, even if every enemy has a small AgroRadius
+	float MinCellSize;
+
+	//! Edge length of a cell, the largest AgroRadius of the registered enemies plus the largest character radius
+	float CellSize;
+};
@@ -0,0 +1,76 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+
+#include "EnemyArchetypeSubsystem.h"
+#include "Engine/World.h"
+#include "Engine/GameInstance.h"
+#include "UltimateShooter/Characters/Enemy.h"
+#include "UltimateShooter/Characters/EnemyArchetype.h"
+
+FDefaultArchetypeKey::FDefaultArchetypeKey(const AEnemy* Enemy)
+	: EnemyClass{ Enemy->GetClass() }, EnemyType{ Enemy->GetEnemyType() },
+	AttackSections{ Enemy->GetAttackLFast(), Enemy->GetAttackRFast(), Enemy->GetAttackCFast(), Enemy->GetAttackL(),
+		Enemy->GetAttackR(), Enemy->GetAttackC() },
+	HeadshotParticles{ Enemy->GetMinionDeathParticles() }, HeadshotSound{ Enemy->GetHeadshotExplosionSound() }
+{
+}
+
+bool FDefaultArchetypeKey::operator==(const FDefaultArchetypeKey& Other) const
+{
+	for (int32 Index = 0; Index < UE_ARRAY_COUNT(AttackSections); Index++)
+	{
+		if (AttackSections[Index] != Other.AttackSections[Index]) return false;
+	}
+
+	return EnemyClass == Other.EnemyClass && EnemyType == Other.EnemyType && HeadshotParticles == Other.HeadshotParticles
+		&& HeadshotSound == Other.HeadshotSound;
+}
+
+uint32 GetTypeHash(const FDefaultArchetypeKey& Key)
+{
+	uint32 Hash = HashCombine(GetTypeHash(Key.EnemyClass), GetTypeHash(Key.EnemyType));
+	for (const FName& Section : Key.AttackSections)
+	{
+		Hash = HashCombine(Hash, GetTypeHash(Section));
+	}
+
+	Hash = HashCombine(Hash, GetTypeHash(Key.HeadshotParticles));
+	return HashCombine(Hash, GetTypeHash(Key.HeadshotSound));
+}
+
+void UEnemyArchetypeSubsystem::Deinitialize()
+{
+	DefaultArchetypes.Empty();
+	BuiltArchetypes.Empty();
+
+	Super::Deinitialize();
+}
+
+UEnemyArchetype* UEnemyArchetypeSubsystem::ResolveArchetype(const AEnemy* Enemy)
+{
+	if (Enemy == nullptr) return nullptr;
+
+	if (UEnemyArchetype* Archetype = Enemy->GetArchetypeAsset())
+	{
+		return Archetype;
+	}
+
+	//! Built from the enemy itself, instances that override any value the archetype is built from get their own archetype
+	const FDefaultArchetypeKey Key{ Enemy };
+	if (UEnemyArchetype** Archetype = DefaultArchetypes.Find(Key))
+	{
+		return *Archetype;
+	}
+
+	UEnemyArchetype* Archetype = Enemy->CreateDefaultArchetype(this);
+	DefaultArchetypes.Add(Key, Archetype);
+	BuiltArchetypes.Add(Archetype);
+	return Archetype;
+}
+
+UEnemyArchetypeSubsystem* UEnemyArchetypeSubsystem::Get(const UObject* WorldContextObject)
+{
+	const UWorld* World = WorldContextObject ? WorldContextObject->GetWorld() : nullptr;
+	const UGameInstance* GameInstance = World ? World->GetGameInstance() : nullptr;
+	return GameInstance ? GameInstance->GetSubsystem<UEnemyArchetypeSubsystem>() : nullptr;
+}
@@ -0,0 +1,74 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Subsystems/GameInstanceSubsystem.h"
+#include "UObject/ObjectKey.h"
+#include "EnemyArchetypeSubsystem.generated.h"
+
+class AEnemy;
+class UEnemyArchetype;
+
+//! Every enemy value AEnemy::CreateDefaultArchetype() reads, enemies with equal keys share a built archetype
+struct FDefaultArchetypeKey
+{
+	FObjectKey EnemyClass;
+	FName EnemyType;
+
+	//! AttackLFast, AttackRFast, AttackCFast, AttackL, AttackR and AttackC
+	FName AttackSections[6];
+
+	FObjectKey HeadshotParticles;
+	FObjectKey HeadshotSound;
+
+	explicit FDefaultArchetypeKey(const AEnemy* Enemy);
+
+	bool operator==(const FDefaultArchetypeKey& Other) const;
+
+	friend uint32 GetTypeHash(const FDefaultArchetypeKey& Key);
+};
+
+/**
+ * @brief Resolves the UEnemyArchetype of every enemy class once per game.
+ * 
+ * An enemy with an Archetype asset uses it as is. For an enemy without one an archetype is built from its EnemyType,
+ * attack section names and headshot FX the first time an enemy with those values begins play, and shared by every
+ * enemy of the same class with the same values after that. The values are read from the enemy itself, so level instance overrides and
+ * construction script writes are kept.
+ */
+UCLASS()
+class ULTIMATESHOOTER_API UEnemyArchetypeSubsystem : public UGameInstanceSubsystem
+{
+	GENERATED_BODY()
+
+public:
+	/**
+	 * @brief Releases the archetypes built for enemies without an asset
+	 * 
+	 */
+	virtual void Deinitialize() override;
+
+	/**
+	 * @brief Gets the archetype of the enemy
+	 * 
+	 * @param Enemy Enemy to get the archetype for
+	 * @return UEnemyArchetype* Archetype asset of the enemy, or the one built from its values
+	 */
+	UEnemyArchetype* ResolveArchetype(const AEnemy* Enemy);
+
+	/**
+	 * @brief Gets the archetype subsystem of the game instance WorldContextObject is in
+	 * 
+	 * @return UEnemyArchetypeSubsystem* Subsystem, or nullptr outside of a game
+	 */
+	static UEnemyArchetypeSubsystem* Get(const UObject* WorldContextObject);
+
+private:
+	//! Archetypes built for enemies that have no asset
+	TMap<FDefaultArchetypeKey, UEnemyArchetype*> DefaultArchetypes;
+
+	//! Keeps the archetypes in DefaultArchetypes referenced, the map is not visible to the garbage collector
+	UPROPERTY()
+	TArray<UEnemyArchetype*> BuiltArchetypes;
+};
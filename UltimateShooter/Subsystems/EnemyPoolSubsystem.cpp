@@ -0,0 +1,112 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+
+#include "EnemyPoolSubsystem.h"
+#include "Engine/World.h"
+#include "UltimateShooter/Characters/Enemy.h"
+#include "UltimateShooter/UltimateShooter.h"
+
+DECLARE_CYCLE_STAT(TEXT("Enemy Spawn"), STAT_EnemySpawn, STATGROUP_UltimateShooter);
+DECLARE_DWORD_COUNTER_STAT(TEXT("Enemies Spawned New"), STAT_EnemiesSpawnedNew, STATGROUP_UltimateShooter);
+DECLARE_DWORD_COUNTER_STAT(TEXT("Enemies Reused"), STAT_EnemiesReused, STATGROUP_UltimateShooter);
+DECLARE_DWORD_COUNTER_STAT(TEXT("Enemies Destroyed"), STAT_EnemiesDestroyed, STATGROUP_UltimateShooter);
+DECLARE_DWORD_ACCUMULATOR_STAT(TEXT("Pooled Enemies"), STAT_PooledEnemies, STATGROUP_UltimateShooter);
+
+UEnemyPoolSubsystem::UEnemyPoolSubsystem() :
+	MaxPooledPerClass{128}
+{
+}
+
+void UEnemyPoolSubsystem::Deinitialize()
+{
+	for (const auto& PoolPair : Pools)
+	{
+		DEC_DWORD_STAT_BY(STAT_PooledEnemies, PoolPair.Value.Enemies.Num());
+	}
+	Pools.Empty();
+
+	Super::Deinitialize();
+}
+
+AEnemy* UEnemyPoolSubsystem::SpawnEnemy(TSubclassOf<AEnemy> EnemyClass, const FTransform& Transform)
+{
+	if (EnemyClass == nullptr) return nullptr;
+
+	SCOPE_CYCLE_COUNTER(STAT_EnemySpawn);
+
+	//! Adding the entry marks the class as pooled, so its enemies are parked when they die
+	FEnemyPool& Pool = Pools.FindOrAdd(EnemyClass);
+	while (Pool.Enemies.Num() > 0)
+	{
+		AEnemy* Enemy = Pool.Enemies.Pop();
+		DEC_DWORD_STAT(STAT_PooledEnemies);
+
+		if (IsValid(Enemy))
+		{
+			INC_DWORD_STAT(STAT_EnemiesReused);
+			Enemy->ActivateFromPool(Transform);
+			return Enemy;
+		}
+	}
+
+	return SpawnNewEnemy(EnemyClass, Transform);
+}
+
+void UEnemyPoolSubsystem::Prewarm(TSubclassOf<AEnemy> EnemyClass, int32 Count)
+{
+	if (EnemyClass == nullptr) return;
+
+	FEnemyPool& Pool = Pools.FindOrAdd(EnemyClass);
+	const int32 ToSpawn = FMath::Min(Count, MaxPooledPerClass) - Pool.Enemies.Num();
+
+	//! Parked enemies are out of the way below the world origin until they are reused
+	const FTransform ParkingTransform(FVector(0.f, 0.f, -100000.f));
+	for (int32 i = 0; i < ToSpawn; i++)
+	{
+		AEnemy* Enemy = SpawnNewEnemy(EnemyClass, ParkingTransform);
+		if (Enemy == nullptr) return;
+
+		Enemy->DeactivateForPool();
+		Pool.Enemies.Add(Enemy);
+		INC_DWORD_STAT(STAT_PooledEnemies);
+	}
+}
+
+void UEnemyPoolSubsystem::ReleaseEnemy(AEnemy* Enemy)
+{
+	if (!IsValid(Enemy)) return;
+
+	FEnemyPool* Pool = Pools.Find(Enemy->GetClass());
+	if (Pool == nullptr || Pool->Enemies.Num() >= MaxPooledPerClass)
+	{
+		INC_DWORD_STAT(STAT_EnemiesDestroyed);
+		Enemy->Destroy();
+		return;
+	}
+
+	Enemy->DeactivateForPool();
+	Pool->Enemies.Add(Enemy);
+	INC_DWORD_STAT(STAT_PooledEnemies);
+}
+
+UEnemyPoolSubsystem* UEnemyPoolSubsystem::Get(const UObject* WorldContextObject)
+{
+	UWorld* World = WorldContextObject ? WorldContextObject->GetWorld() : nullptr;
+	if (World == nullptr) return nullptr;
+
+	return World->GetSubsystem<UEnemyPoolSubsystem>();
+}
+
+AEnemy* UEnemyPoolSubsystem::SpawnNewEnemy(TSubclassOf<AEnemy> EnemyClass, const FTransform& Transform)
+{
+	AEnemy* Enemy = GetWorld()->SpawnActorDeferred<AEnemy>(EnemyClass, Transform, nullptr, nullptr,
+		ESpawnActorCollisionHandlingMethod::AdjustIfPossibleButAlwaysSpawn);
+	if (Enemy == nullptr) return nullptr;
+
+	//! Controller has to exist before BeginPlay starts the behavior tree
+	Enemy->AutoPossessAI = EAutoPossessAI::PlacedInWorldOrSpawned;
+	Enemy->FinishSpawning(Transform);
+
+	INC_DWORD_STAT(STAT_EnemiesSpawnedNew);
+	return Enemy;
+}
@@ -0,0 +1,89 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Subsystems/WorldSubsystem.h"
+#include "EnemyPoolSubsystem.generated.h"
+
+class AEnemy;
+
+//! Parked enemies of one class
+USTRUCT()
+struct FEnemyPool
+{
+	GENERATED_BODY()
+
+	UPROPERTY()
+	TArray<AEnemy*> Enemies;
+};
+
+/**
+ * @brief Keeps dead enemies parked per class and reactivates them instead of spawning new ones.
+ * 
+ * AEnemy::FinishDeath releases the enemy here instead of destroying it. SpawnEnemy reuses a parked enemy of the class
+ * when there is one, so a wave only pays for SpawnActor, controller possession and blackboard initialization the first
+ * time an enemy of that class is needed. Only classes passed to SpawnEnemy or Prewarm are pooled, enemies of other
+ * classes, like the ones placed in the level, are destroyed when released since nothing would ever reuse them.
+ */
+UCLASS()
+class ULTIMATESHOOTER_API UEnemyPoolSubsystem : public UWorldSubsystem
+{
+	GENERATED_BODY()
+
+public:
+	UEnemyPoolSubsystem();
+
+	/**
+	 * @brief Drops all parked enemies
+	 * 
+	 */
+	virtual void Deinitialize() override;
+
+	/**
+	 * @brief Reactivates a parked enemy of EnemyClass at Transform, or spawns a new one if none is parked
+	 * 
+	 * @param EnemyClass Class of the enemy to spawn
+	 * @param Transform Where the enemy is spawned
+	 * @return AEnemy* Spawned enemy, or nullptr if EnemyClass is not set
+	 */
+	UFUNCTION(BlueprintCallable, Category = "Enemy Pool")
+	AEnemy* SpawnEnemy(TSubclassOf<AEnemy> EnemyClass, const FTransform& Transform);
+
+	/**
+	 * @brief Spawns Count enemies of EnemyClass and parks them right away, so the first wave does not pay for spawning
+	 * 
+	 * @param EnemyClass Class of the enemies to spawn
+	 * @param Count Number of enemies to park
+	 */
+	UFUNCTION(BlueprintCallable, Category = "Enemy Pool")
+	void Prewarm(TSubclassOf<AEnemy> EnemyClass, int32 Count);
+
+	/**
+	 * @brief Parks the enemy for reuse, destroys it if its class is not pooled or the pool of its class is full
+	 * 
+	 * @param Enemy Dead enemy that finished its death animation
+	 */
+	void ReleaseEnemy(AEnemy* Enemy);
+
+	/**
+	 * @brief Gets the enemy pool of the world WorldContextObject is in
+	 * 
+	 * @return UEnemyPoolSubsystem* Subsystem, or nullptr if there is no world
+	 */
+	static UEnemyPoolSubsystem* Get(const UObject* WorldContextObject);
+
+private:
+	/**
+	 * @brief Spawns a new enemy that is possessed by its AI controller before BeginPlay
+	 * 
+	 */
+	AEnemy* SpawnNewEnemy(TSubclassOf<AEnemy> EnemyClass, const FTransform& Transform);
+
+	//! Parked enemies keyed by class, a class has an entry once it was spawned through the pool or prewarmed
+	UPROPERTY()
+	TMap<UClass*, FEnemyPool> Pools;
+
+	//! Enemies over this number per class are destroyed when released
+	int32 MaxPooledPerClass;
+};
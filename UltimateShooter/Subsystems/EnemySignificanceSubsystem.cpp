@@ -0,0 +1,141 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+
+#include "EnemySignificanceSubsystem.h"
+#include "Engine/World.h"
+#include "GameFramework/PlayerController.h"
+#include "Camera/PlayerCameraManager.h"
+#include "UltimateShooter/Characters/Enemy.h"
+#include "UltimateShooter/UltimateShooter.h"
+
+DECLARE_CYCLE_STAT(TEXT("Enemy Significance Update"), STAT_EnemySignificanceUpdate, STATGROUP_UltimateShooter);
+DECLARE_DWORD_ACCUMULATOR_STAT(TEXT("Enemies High Significance"), STAT_EnemiesHighSignificance, STATGROUP_UltimateShooter);
+DECLARE_DWORD_ACCUMULATOR_STAT(TEXT("Enemies Medium Significance"), STAT_EnemiesMediumSignificance, STATGROUP_UltimateShooter);
+DECLARE_DWORD_ACCUMULATOR_STAT(TEXT("Enemies Low Significance"), STAT_EnemiesLowSignificance, STATGROUP_UltimateShooter);
+DECLARE_DWORD_ACCUMULATOR_STAT(TEXT("Enemies Dormant"), STAT_EnemiesDormant, STATGROUP_UltimateShooter);
+
+UEnemySignificanceSubsystem::UEnemySignificanceSubsystem() :
+	UpdateInterval{0.25f},
+	TimeSinceUpdate{0.f},
+	HighTierDistance{1500.f},
+	MediumTierDistance{3500.f},
+	LowTierDistance{7000.f},
+	OffscreenDistanceScale{2.f}
+{
+}
+
+void UEnemySignificanceSubsystem::Tick(float DeltaTime)
+{
+	Super::Tick(DeltaTime);
+
+	TimeSinceUpdate += DeltaTime;
+	if (TimeSinceUpdate < UpdateInterval) return;
+	TimeSinceUpdate = 0.f;
+
+	SCOPE_CYCLE_COUNTER(STAT_EnemySignificanceUpdate);
+
+	FVector ViewLocation;
+	if (!GetViewLocation(ViewLocation)) return;
+
+	int32 TierCounts[static_cast<int32>(ESignificanceTier::EST_MAX)] = {};
+
+	for (int32 i = Enemies.Num() - 1; i >= 0; i--)
+	{
+		AEnemy* Enemy = Enemies[i].Get();
+		if (Enemy == nullptr)
+		{
+			Enemies.RemoveAtSwap(i);
+			continue;
+		}
+
+		const ESignificanceTier Tier = ScoreEnemy(Enemy, ViewLocation);
+		Enemy->SetSignificanceTier(Tier);
+		TierCounts[static_cast<int32>(Tier)]++;
+	}
+
+	SET_DWORD_STAT(STAT_EnemiesHighSignificance, TierCounts[static_cast<int32>(ESignificanceTier::EST_High)]);
+	SET_DWORD_STAT(STAT_EnemiesMediumSignificance, TierCounts[static_cast<int32>(ESignificanceTier::EST_Medium)]);
+	SET_DWORD_STAT(STAT_EnemiesLowSignificance, TierCounts[static_cast<int32>(ESignificanceTier::EST_Low)]);
+	SET_DWORD_STAT(STAT_EnemiesDormant, TierCounts[static_cast<int32>(ESignificanceTier::EST_Dormant)]);
+}
+
+TStatId UEnemySignificanceSubsystem::GetStatId() const
+{
+	RETURN_QUICK_DECLARE_CYCLE_STAT(UEnemySignificanceSubsystem, STATGROUP_Tickables);
+}
+
+void UEnemySignificanceSubsystem::RegisterEnemy(AEnemy* Enemy)
+{
+	if (Enemy == nullptr) return;
+
+	Enemies.AddUnique(Enemy);
+}
+
+void UEnemySignificanceSubsystem::UnregisterEnemy(AEnemy* Enemy)
+{
+	if (Enemy == nullptr) return;
+
+	if (Enemies.RemoveSwap(Enemy) > 0)
+	{
+		Enemy->SetSignificanceTier(ESignificanceTier::EST_High);
+	}
+}
+
+UEnemySignificanceSubsystem* UEnemySignificanceSubsystem::Get(const UObject* WorldContextObject)
+{
+	UWorld* World = WorldContextObject ? WorldContextObject->GetWorld() : nullptr;
+	if (World == nullptr) return nullptr;
+
+	return World->GetSubsystem<UEnemySignificanceSubsystem>();
+}
+
+ESignificanceTier UEnemySignificanceSubsystem::ScoreEnemy(const AEnemy* Enemy, const FVector& ViewLocation) const
+{
+	float Distance = FVector::Dist(Enemy->GetActorLocation(), ViewLocation);
+	if (!Enemy->WasRecentlyRendered(UpdateInterval))
+	{
+		Distance *= OffscreenDistanceScale;
+	}
+
+	ESignificanceTier Tier = ESignificanceTier::EST_Dormant;
+	if (Distance < HighTierDistance)
+	{
+		Tier = ESignificanceTier::EST_High;
+	}
+	else if (Distance < MediumTierDistance)
+	{
+		Tier = ESignificanceTier::EST_Medium;
+	}
+	else if (Distance < LowTierDistance)
+	{
+		Tier = ESignificanceTier::EST_Low;
+	}
+
+	//! Enemies chasing or attacking must keep reacting
+	if (Enemy->IsInCombat() && Tier > ESignificanceTier::EST_Medium)
+	{
+		Tier = ESignificanceTier::EST_Medium;
+	}
+
+	return Tier;
+}
+
+bool UEnemySignificanceSubsystem::GetViewLocation(FVector& OutViewLocation) const
+{
+	APlayerController* PlayerController = GetWorld()->GetFirstPlayerController();
+	if (PlayerController == nullptr) return false;
+
+	if (PlayerController->PlayerCameraManager)
+	{
+		OutViewLocation = PlayerController->PlayerCameraManager->GetCameraLocation();
+		return true;
+	}
+
+	if (APawn* Pawn = PlayerController->GetPawn())
+	{
+		OutViewLocation = Pawn->GetActorLocation();
+		return true;
+	}
+
+	return false;
+}
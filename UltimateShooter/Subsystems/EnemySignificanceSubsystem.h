@@ -0,0 +1,91 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Subsystems/WorldSubsystem.h"
+#include "UltimateShooter/Enums/SignificanceTier.h"
+#include "EnemySignificanceSubsystem.generated.h"
+
+/**
+ * @brief Scores every live enemy by distance to the player camera, visibility and combat state, and puts it in a
+ * significance tier.
+ * 
+ * The tier is handed to AEnemy::SetSignificanceTier, which throttles the enemy's tick, behavior tree, animation and
+ * overlap work. Enemies are re-scored every UpdateInterval seconds, not every frame.
+ */
+UCLASS()
+class ULTIMATESHOOTER_API UEnemySignificanceSubsystem : public UTickableWorldSubsystem
+{
+	GENERATED_BODY()
+
+public:
+	UEnemySignificanceSubsystem();
+
+	/**
+	 * @brief Re-scores all registered enemies once UpdateInterval has passed
+	 * 
+	 * @param DeltaTime The time elapsed since the last frame.
+	 */
+	virtual void Tick(float DeltaTime) override;
+
+	virtual TStatId GetStatId() const override;
+
+	/**
+	 * @brief Starts managing the enemy, it is scored on the next update
+	 * 
+	 * @param Enemy Enemy that started play
+	 */
+	void RegisterEnemy(class AEnemy* Enemy);
+
+	/**
+	 * @brief Stops managing the enemy and puts it back into the High tier
+	 * 
+	 * @param Enemy Enemy that died or left play
+	 */
+	void UnregisterEnemy(AEnemy* Enemy);
+
+	/**
+	 * @brief Gets the significance subsystem of the world WorldContextObject is in
+	 * 
+	 * @return UEnemySignificanceSubsystem* Subsystem, or nullptr if there is no world
+	 */
+	static UEnemySignificanceSubsystem* Get(const UObject* WorldContextObject);
+
+private:
+	/**
+	 * @brief Picks the tier of one enemy
+	 * 
+	 * Distance is scaled up for enemies that were not rendered recently, so off-screen enemies drop tiers sooner.
+	 * Enemies that have a target or are in attack range never drop below Medium.
+	 * 
+	 * @param Enemy Enemy to score
+	 * @param ViewLocation Location of the player camera
+	 * @return ESignificanceTier Tier for the enemy
+	 */
+	ESignificanceTier ScoreEnemy(const AEnemy* Enemy, const FVector& ViewLocation) const;
+
+	/**
+	 * @brief Gets the location significance is measured from
+	 * 
+	 * @param OutViewLocation Player camera location, or player pawn location if there is no camera manager
+	 * @return true if there is a local player to measure from
+	 */
+	bool GetViewLocation(FVector& OutViewLocation) const;
+
+	//! Enemies currently managed
+	TArray<TWeakObjectPtr<AEnemy>> Enemies;
+
+	//! Seconds between two scoring passes
+	float UpdateInterval;
+
+	float TimeSinceUpdate;
+
+	//! Enemies closer than these distances are in the High, Medium and Low tier, the rest are Dormant
+	float HighTierDistance;
+	float MediumTierDistance;
+	float LowTierDistance;
+
+	//! Distance multiplier for enemies that were not rendered recently
+	float OffscreenDistanceScale;
+};
@@ -0,0 +1,159 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+
+#include "FXBudgetSubsystem.h"
+#include "Engine/World.h"
+#include "GameFramework/PlayerController.h"
+#include "Camera/PlayerCameraManager.h"
+#include "Kismet/GameplayStatics.h"
+#include "Particles/ParticleSystem.h"
+#include "Particles/ParticleSystemComponent.h"
+#include "UltimateShooter/UltimateShooter.h"
+
+DECLARE_DWORD_COUNTER_STAT(TEXT("FX Spawns"), STAT_FXSpawns, STATGROUP_UltimateShooter);
+DECLARE_DWORD_COUNTER_STAT(TEXT("FX Components Allocated"), STAT_FXComponentsAllocated, STATGROUP_UltimateShooter);
+DECLARE_DWORD_COUNTER_STAT(TEXT("FX Spawns Culled"), STAT_FXSpawnsCulled, STATGROUP_UltimateShooter);
+DECLARE_DWORD_COUNTER_STAT(TEXT("FX Spawns Over Budget"), STAT_FXSpawnsOverBudget, STATGROUP_UltimateShooter);
+DECLARE_DWORD_ACCUMULATOR_STAT(TEXT("FX Allocations Per Second"), STAT_FXAllocationsPerSecond, STATGROUP_UltimateShooter);
+
+UFXBudgetSubsystem::UFXBudgetSubsystem() :
+	MaxSpawnsPerFrame{24},
+	SpawnsThisFrame{0},
+	CullDistance{8000.f},
+	AlwaysSpawnDistance{1000.f},
+	ViewLocation{FVector::ZeroVector},
+	ViewDirection{FVector::ForwardVector},
+	bHasView{false},
+	AllocationsThisWindow{0},
+	AllocationWindowTime{0.f}
+{
+}
+
+void UFXBudgetSubsystem::Tick(float DeltaTime)
+{
+	Super::Tick(DeltaTime);
+
+	SpawnsThisFrame = 0;
+
+	APlayerController* PlayerController = GetWorld()->GetFirstPlayerController();
+	bHasView = PlayerController && PlayerController->PlayerCameraManager;
+	if (bHasView)
+	{
+		ViewLocation = PlayerController->PlayerCameraManager->GetCameraLocation();
+		ViewDirection = PlayerController->PlayerCameraManager->GetCameraRotation().Vector();
+	}
+
+	AllocationWindowTime += DeltaTime;
+	if (AllocationWindowTime >= 1.f)
+	{
+		SET_DWORD_STAT(STAT_FXAllocationsPerSecond, AllocationsThisWindow);
+		AllocationsThisWindow = 0;
+		AllocationWindowTime = 0.f;
+
+		//! Components the engine pool destroyed are forgotten
+		for (auto It = SeenComponents.CreateIterator(); It; ++It)
+		{
+			if (!It->IsValid())
+			{
+				It.RemoveCurrent();
+			}
+		}
+	}
+}
+
+TStatId UFXBudgetSubsystem::GetStatId() const
+{
+	RETURN_QUICK_DECLARE_CYCLE_STAT(UFXBudgetSubsystem, STATGROUP_Tickables);
+}
+
+UParticleSystemComponent* UFXBudgetSubsystem::SpawnEmitterAtLocation(const UObject* WorldContextObject, UParticleSystem* Template,
+	const FTransform& Transform)
+{
+	if (Template == nullptr) return nullptr;
+
+	UFXBudgetSubsystem* FXBudget = Get(WorldContextObject);
+	if (FXBudget == nullptr)
+	{
+		return UGameplayStatics::SpawnEmitterAtLocation(WorldContextObject, Template, Transform);
+	}
+
+	if (!FXBudget->ShouldSpawn(Transform.GetLocation())) return nullptr;
+
+	return FXBudget->TrackComponent(UGameplayStatics::SpawnEmitterAtLocation(WorldContextObject, Template, Transform, true,
+		EPSCPoolMethod::AutoRelease));
+}
+
+UParticleSystemComponent* UFXBudgetSubsystem::SpawnEmitterAttached(UParticleSystem* Template, USceneComponent* AttachToComponent,
+	FName SocketName)
+{
+	if (Template == nullptr || AttachToComponent == nullptr) return nullptr;
+
+	UFXBudgetSubsystem* FXBudget = Get(AttachToComponent);
+	if (FXBudget == nullptr)
+	{
+		return UGameplayStatics::SpawnEmitterAttached(Template, AttachToComponent, SocketName);
+	}
+
+	//! Attached effects follow something the player is holding, only the budget applies
+	if (FXBudget->SpawnsThisFrame >= FXBudget->MaxSpawnsPerFrame)
+	{
+		INC_DWORD_STAT(STAT_FXSpawnsOverBudget);
+		return nullptr;
+	}
+	FXBudget->SpawnsThisFrame++;
+	INC_DWORD_STAT(STAT_FXSpawns);
+
+	return FXBudget->TrackComponent(UGameplayStatics::SpawnEmitterAttached(Template, AttachToComponent, SocketName,
+		FVector::ZeroVector, FRotator::ZeroRotator, EAttachLocation::KeepRelativeOffset, true, EPSCPoolMethod::AutoRelease));
+}
+
+UFXBudgetSubsystem* UFXBudgetSubsystem::Get(const UObject* WorldContextObject)
+{
+	UWorld* World = WorldContextObject ? WorldContextObject->GetWorld() : nullptr;
+	if (World == nullptr) return nullptr;
+
+	return World->GetSubsystem<UFXBudgetSubsystem>();
+}
+
+bool UFXBudgetSubsystem::ShouldSpawn(const FVector& Location)
+{
+	if (bHasView)
+	{
+		const FVector ToLocation = Location - ViewLocation;
+		const float DistanceSquared = ToLocation.SizeSquared();
+
+		const bool bTooFar = DistanceSquared > FMath::Square(CullDistance);
+		const bool bBehindView = DistanceSquared > FMath::Square(AlwaysSpawnDistance) &&
+			FVector::DotProduct(ToLocation, ViewDirection) < 0.f;
+		if (bTooFar || bBehindView)
+		{
+			INC_DWORD_STAT(STAT_FXSpawnsCulled);
+			return false;
+		}
+	}
+
+	if (SpawnsThisFrame >= MaxSpawnsPerFrame)
+	{
+		INC_DWORD_STAT(STAT_FXSpawnsOverBudget);
+		return false;
+	}
+
+	SpawnsThisFrame++;
+	INC_DWORD_STAT(STAT_FXSpawns);
+	return true;
+}
+
+UParticleSystemComponent* UFXBudgetSubsystem::TrackComponent(UParticleSystemComponent* Component)
+{
+	if (Component == nullptr) return nullptr;
+
+	bool bAlreadySeen = false;
+	SeenComponents.Add(Component, &bAlreadySeen);
+	if (!bAlreadySeen)
+	{
+		AllocationsThisWindow++;
+		INC_DWORD_STAT(STAT_FXComponentsAllocated);
+	}
+
+	return Component;
+}
@@ -0,0 +1,109 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Subsystems/WorldSubsystem.h"
+#include "FXBudgetSubsystem.generated.h"
+
+class UParticleSystem;
+class UParticleSystemComponent;
+
+/**
+ * @brief Spawns impact, beam, muzzle and blood particles under a frame budget, from the engine's component pool.
+ * 
+ * Components come from the world's particle system component pool with EPSCPoolMethod::AutoRelease and go back to it
+ * when the system finishes. Before a spawn the location is culled by distance and by being behind the player camera,
+ * and at most MaxSpawnsPerFrame effects are spawned per frame, the rest are dropped. Components the engine pool had to
+ * create are counted as allocations per second.
+ */
+UCLASS()
+class ULTIMATESHOOTER_API UFXBudgetSubsystem : public UTickableWorldSubsystem
+{
+	GENERATED_BODY()
+
+public:
+	UFXBudgetSubsystem();
+
+	/**
+	 * @brief Resets the frame budget, caches the player camera for culling and updates the allocation stats
+	 * 
+	 * @param DeltaTime The time elapsed since the last frame.
+	 */
+	virtual void Tick(float DeltaTime) override;
+
+	virtual TStatId GetStatId() const override;
+
+	/**
+	 * @brief Budgeted replacement for UGameplayStatics::SpawnEmitterAtLocation
+	 * 
+	 * Spawns without a budget if the world has no FX budget. The returned component goes back to the engine's pool when
+	 * it finishes, so it must not be kept.
+	 * 
+	 * @param WorldContextObject Object used to find the world
+	 * @param Template Particle system to spawn
+	 * @param Transform Where the particle system is spawned
+	 * @return UParticleSystemComponent* Active component, or nullptr if the spawn was culled or over budget
+	 */
+	static UParticleSystemComponent* SpawnEmitterAtLocation(const UObject* WorldContextObject, UParticleSystem* Template,
+		const FTransform& Transform);
+
+	/**
+	 * @brief Budgeted replacement for UGameplayStatics::SpawnEmitterAttached
+	 * 
+	 * The returned component goes back to the engine's pool when it finishes, so it must not be kept.
+	 * 
+	 * @param Template Particle system to spawn
+	 * @param AttachToComponent Component to attach the particle system to
+	 * @param SocketName Socket on AttachToComponent
+	 * @return UParticleSystemComponent* Active component, or nullptr if the spawn was over budget
+	 */
+	static UParticleSystemComponent* SpawnEmitterAttached(UParticleSystem* Template, USceneComponent* AttachToComponent,
+		FName SocketName);
+
+	/**
+	 * @brief Gets the FX budget of the world WorldContextObject is in
+	 * 
+	 * @return UFXBudgetSubsystem* Subsystem, or nullptr if there is no world
+	 */
+	static UFXBudgetSubsystem* Get(const UObject* WorldContextObject);
+
+private:
+	/**
+	 * @brief Checks the frame budget and culls locations too far away or behind the camera
+	 * 
+	 * @param Location Where the effect would be spawned
+	 * @return true if the effect should be spawned
+	 */
+	bool ShouldSpawn(const FVector& Location);
+
+	/**
+	 * @brief Counts Component as an allocation if the engine pool handed it out for the first time
+	 * 
+	 * @return UParticleSystemComponent* Component, passed through
+	 */
+	UParticleSystemComponent* TrackComponent(UParticleSystemComponent* Component);
+
+	//! Most effects spawned in one frame
+	int32 MaxSpawnsPerFrame;
+
+	int32 SpawnsThisFrame;
+
+	//! Effects further from the camera than this are not spawned
+	float CullDistance;
+
+	//! Effects closer than this are spawned even if they are behind the camera
+	float AlwaysSpawnDistance;
+
+	//! Player camera from the start of the frame
+	FVector ViewLocation;
+	FVector ViewDirection;
+	bool bHasView;
+
+	//! Components handed out by the engine pool so far, a component not in here was just created
+	TSet<TWeakObjectPtr<UParticleSystemComponent>> SeenComponents;
+
+	//! Components created in the current one second window
+	int32 AllocationsThisWindow;
+	float AllocationWindowTime;
+};
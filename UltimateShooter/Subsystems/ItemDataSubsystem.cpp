@@ -0,0 +1,260 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+
+#include "ItemDataSubsystem.h"
+#include "Engine/GameInstance.h"
+#include "Engine/World.h"
+#include "Engine/AssetManager.h"
+#include "UltimateShooter/UltimateShooter.h"
+
+DECLARE_DWORD_COUNTER_STAT(TEXT("Weapon Asset Sync Loads"), STAT_WeaponAssetSyncLoads, STATGROUP_UltimateShooter);
+DECLARE_DWORD_COUNTER_STAT(TEXT("Weapon Asset Requests"), STAT_WeaponAssetRequests, STATGROUP_UltimateShooter);
+DECLARE_MEMORY_STAT(TEXT("Weapon Assets SubmachineGun"), STAT_WeaponAssetsSubmachineGun, STATGROUP_UltimateShooter);
+DECLARE_MEMORY_STAT(TEXT("Weapon Assets AssaultRifle"), STAT_WeaponAssetsAssaultRifle, STATGROUP_UltimateShooter);
+DECLARE_MEMORY_STAT(TEXT("Weapon Assets Pistol"), STAT_WeaponAssetsPistol, STATGROUP_UltimateShooter);
+
+void UItemDataSubsystem::Initialize(FSubsystemCollectionBase& Collection)
+{
+	Super::Initialize(Collection);
+
+	WeaponDataTable = LoadWeaponDataTable();
+	RarityDataTable = LoadRarityDataTable();
+
+	WeaponRows.Init(nullptr, static_cast<int32>(EWeaponType::EWT_DefaultMAX));
+	WeaponAssetHandles.SetNum(static_cast<int32>(EWeaponType::EWT_DefaultMAX));
+	RarityRows.Init(nullptr, static_cast<int32>(EItemRarity::EIR_MAX));
+
+	if (WeaponDataTable)
+	{
+		for (int32 i = 0; i < WeaponRows.Num(); i++)
+		{
+			WeaponRows[i] = WeaponDataTable->FindRow<FWeaponDataTable>(GetWeaponRowName(static_cast<EWeaponType>(i)), TEXT(""));
+		}
+	}
+
+	if (RarityDataTable)
+	{
+		for (int32 i = 0; i < RarityRows.Num(); i++)
+		{
+			RarityRows[i] = RarityDataTable->FindRow<FItemRarityTable>(GetRarityRowName(static_cast<EItemRarity>(i)), TEXT(""));
+		}
+	}
+}
+
+void UItemDataSubsystem::Deinitialize()
+{
+	for (int32 i = 0; i < WeaponAssetHandles.Num(); i++)
+	{
+		if (WeaponAssetHandles[i].IsValid())
+		{
+			WeaponAssetHandles[i]->ReleaseHandle();
+			SetWeaponAssetMemoryStat(static_cast<EWeaponType>(i), 0);
+		}
+	}
+	WeaponAssetHandles.Empty();
+
+	WeaponRows.Empty();
+	RarityRows.Empty();
+	WeaponDataTable = nullptr;
+	RarityDataTable = nullptr;
+
+	Super::Deinitialize();
+}
+
+const FWeaponDataTable* UItemDataSubsystem::GetWeaponData(EWeaponType Type) const
+{
+	const int32 Index = static_cast<int32>(Type);
+	return WeaponRows.IsValidIndex(Index) ? WeaponRows[Index] : nullptr;
+}
+
+const FItemRarityTable* UItemDataSubsystem::GetRarityData(EItemRarity Rarity) const
+{
+	const int32 Index = static_cast<int32>(Rarity);
+	return RarityRows.IsValidIndex(Index) ? RarityRows[Index] : nullptr;
+}
+
+const FWeaponDataTable* UItemDataSubsystem::FindWeaponData(const UObject* WorldContextObject, EWeaponType Type)
+{
+	if (const UItemDataSubsystem* ItemData = Get(WorldContextObject))
+	{
+		return ItemData->GetWeaponData(Type);
+	}
+
+	//! No game instance, editor construction script
+	UDataTable* Table = LoadWeaponDataTable();
+	return Table ? Table->FindRow<FWeaponDataTable>(GetWeaponRowName(Type), TEXT("")) : nullptr;
+}
+
+const FItemRarityTable* UItemDataSubsystem::FindRarityData(const UObject* WorldContextObject, EItemRarity Rarity)
+{
+	if (const UItemDataSubsystem* ItemData = Get(WorldContextObject))
+	{
+		return ItemData->GetRarityData(Rarity);
+	}
+
+	//! No game instance, editor construction script
+	UDataTable* Table = LoadRarityDataTable();
+	return Table ? Table->FindRow<FItemRarityTable>(GetRarityRowName(Rarity), TEXT("")) : nullptr;
+}
+
+UItemDataSubsystem* UItemDataSubsystem::Get(const UObject* WorldContextObject)
+{
+	const UWorld* World = WorldContextObject ? WorldContextObject->GetWorld() : nullptr;
+	const UGameInstance* GameInstance = World ? World->GetGameInstance() : nullptr;
+	return GameInstance ? GameInstance->GetSubsystem<UItemDataSubsystem>() : nullptr;
+}
+
+void UItemDataSubsystem::RequestWeaponAssets(EWeaponType Type)
+{
+	const int32 Index = static_cast<int32>(Type);
+	//! Already streaming or streamed in
+	if (!WeaponAssetHandles.IsValidIndex(Index) || WeaponAssetHandles[Index].IsValid()) return;
+
+	const FWeaponDataTable* WeaponRow = GetWeaponData(Type);
+	if (WeaponRow == nullptr) return;
+
+	TArray<FSoftObjectPath> AssetPaths;
+	GetWeaponAssetPaths(*WeaponRow, AssetPaths);
+	if (AssetPaths.Num() == 0) return;
+
+	WeaponAssetHandles[Index] = UAssetManager::GetStreamableManager().RequestAsyncLoad(AssetPaths, 
+		FStreamableDelegate::CreateUObject(this, &UItemDataSubsystem::OnWeaponAssetsLoaded, Type));
+	INC_DWORD_STAT(STAT_WeaponAssetRequests);
+}
+
+void UItemDataSubsystem::RequestAllWeaponAssets()
+{
+	for (int32 i = 0; i < WeaponAssetHandles.Num(); i++)
+	{
+		RequestWeaponAssets(static_cast<EWeaponType>(i));
+	}
+}
+
+UObject* UItemDataSubsystem::ResolveWeaponAssetPath(const FSoftObjectPath& AssetPath)
+{
+	if (AssetPath.IsNull()) return nullptr;
+
+	if (UObject* Asset = AssetPath.ResolveObject())
+	{
+		return Asset;
+	}
+
+	//! Not streamed in yet, load it now so the weapon never ends up without it
+	INC_DWORD_STAT(STAT_WeaponAssetSyncLoads);
+	return AssetPath.TryLoad();
+}
+
+void UItemDataSubsystem::GetWeaponAssetPaths(const FWeaponDataTable& Row, TArray<FSoftObjectPath>& OutAssetPaths)
+{
+	const FSoftObjectPath AssetPaths[] = 
+	{
+		Row.PickupSound.ToSoftObjectPath(),
+		Row.EquipSound.ToSoftObjectPath(),
+		Row.ItemMesh.ToSoftObjectPath(),
+		Row.InventoryIcon.ToSoftObjectPath(),
+		Row.AmmoIcon.ToSoftObjectPath(),
+		Row.MaterialInstance.ToSoftObjectPath(),
+		Row.AnimBP.ToSoftObjectPath(),
+		Row.CrosshairsMiddle.ToSoftObjectPath(),
+		Row.CrosshairsTop.ToSoftObjectPath(),
+		Row.CrosshairsBottom.ToSoftObjectPath(),
+		Row.CrosshairsLeft.ToSoftObjectPath(),
+		Row.CrosshairsRight.ToSoftObjectPath(),
+		Row.MuzzleFlash.ToSoftObjectPath(),
+		Row.FireSound.ToSoftObjectPath()
+	};
+
+	for (const FSoftObjectPath& AssetPath : AssetPaths)
+	{
+		if (!AssetPath.IsNull())
+		{
+			OutAssetPaths.AddUnique(AssetPath);
+		}
+	}
+}
+
+void UItemDataSubsystem::OnWeaponAssetsLoaded(EWeaponType Type)
+{
+	const int32 Index = static_cast<int32>(Type);
+	if (!WeaponAssetHandles.IsValidIndex(Index) || !WeaponAssetHandles[Index].IsValid()) return;
+
+	TArray<UObject*> LoadedAssets;
+	WeaponAssetHandles[Index]->GetLoadedAssets(LoadedAssets);
+
+	int64 ResidentBytes{ 0 };
+	for (UObject* Asset : LoadedAssets)
+	{
+		if (Asset)
+		{
+			ResidentBytes += Asset->GetResourceSizeBytes(EResourceSizeMode::EstimatedTotal);
+		}
+	}
+
+	SetWeaponAssetMemoryStat(Type, ResidentBytes);
+}
+
+void UItemDataSubsystem::SetWeaponAssetMemoryStat(EWeaponType Type, int64 Bytes)
+{
+	switch (Type)
+	{
+		case EWeaponType::EWT_SubmachineGun:
+			SET_MEMORY_STAT(STAT_WeaponAssetsSubmachineGun, Bytes);
+			break;
+		case EWeaponType::EWT_AssaultRifle:
+			SET_MEMORY_STAT(STAT_WeaponAssetsAssaultRifle, Bytes);
+			break;
+		case EWeaponType::EWT_Pistol:
+			SET_MEMORY_STAT(STAT_WeaponAssetsPistol, Bytes);
+			break;
+		default:
+			break;
+	}
+}
+
+UDataTable* UItemDataSubsystem::LoadWeaponDataTable()
+{
+	//! Path to the Weapon Data Table
+	const FString WeaponTablePath{ TEXT("DataTable'/Game/_Game/DataTable/WeaponDataTable.WeaponDataTable'") };
+	return Cast<UDataTable>(StaticLoadObject(UDataTable::StaticClass(), nullptr, *WeaponTablePath));
+}
+
+UDataTable* UItemDataSubsystem::LoadRarityDataTable()
+{
+	//! Path to the Item Rarity Data Table
+	const FString RarityTablePath{ TEXT("DataTable'/Game/_Game/DataTable/ItemRarityDataTable.ItemRarityDataTable'") };
+	return Cast<UDataTable>(StaticLoadObject(UDataTable::StaticClass(), nullptr, *RarityTablePath));
+}
+
+FName UItemDataSubsystem::GetWeaponRowName(EWeaponType Type)
+{
+	switch (Type)
+	{
+		case EWeaponType::EWT_SubmachineGun:
+			return FName("SubmachineGun");
+		case EWeaponType::EWT_AssaultRifle:
+			return FName("AssaultRifle");
+		case EWeaponType::EWT_Pistol:
+			return FName("Pistol");
+		default:
+			return NAME_None;
+	}
+}
+
+FName UItemDataSubsystem::GetRarityRowName(EItemRarity Rarity)
+{
+	switch (Rarity)
+	{
+		case EItemRarity::EIR_Damaged:
+			return FName("Damaged");
+		case EItemRarity::EIR_Common:
+			return FName("Common");
+		case EItemRarity::EIR_Uncommon:
+			return FName("Uncommon");
+		case EItemRarity::EIR_Rare:
+			return FName("Rare");
+		case EItemRarity::EIR_Legendary:
+			return FName("Legendary");
+		default:
+			return NAME_None;
+	}
+}
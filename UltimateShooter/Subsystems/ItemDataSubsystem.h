@@ -0,0 +1,175 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Subsystems/GameInstanceSubsystem.h"
+#include "Engine/StreamableManager.h"
+#include "UltimateShooter/Weapons/Weapon.h"
+#include "ItemDataSubsystem.generated.h"
+
+/**
+ * @brief Loads the Weapon and Item Rarity Data Tables once per game and keeps their rows indexed by enum.
+ * 
+ * Weapons and items read a const row pointer from here when they are spawned, instead of loading the table by its path
+ * and looking the row up by name every time.
+ * 
+ * Also streams in the soft referenced assets of a weapon type before a weapon of that type is needed, and keeps them
+ * resident for the rest of the game.
+ */
+UCLASS()
+class ULTIMATESHOOTER_API UItemDataSubsystem : public UGameInstanceSubsystem
+{
+	GENERATED_BODY()
+
+public:
+	/**
+	 * @brief Loads WeaponDataTable and ItemRarityDataTable and resolves their rows into WeaponRows and RarityRows
+	 * 
+	 * @param Collection Subsystem collection this subsystem is initialized in
+	 */
+	virtual void Initialize(FSubsystemCollectionBase& Collection) override;
+
+	/**
+	 * @brief Clears the resolved rows and releases the Data Tables
+	 * 
+	 */
+	virtual void Deinitialize() override;
+
+	/**
+	 * @brief Gets the Weapon Data Table row for the weapon type
+	 * 
+	 * @param Type Weapon type to get the row for
+	 * @return const FWeaponDataTable* Row, or nullptr if the table has no row for the type
+	 */
+	const FWeaponDataTable* GetWeaponData(EWeaponType Type) const;
+
+	/**
+	 * @brief Gets the Item Rarity Data Table row for the rarity
+	 * 
+	 * @param Rarity Item rarity to get the row for
+	 * @return const FItemRarityTable* Row, or nullptr if the table has no row for the rarity
+	 */
+	const FItemRarityTable* GetRarityData(EItemRarity Rarity) const;
+
+	/**
+	 * @brief Gets the Weapon Data Table row from the subsystem of the game instance WorldContextObject is in
+	 * 
+	 * Outside of a game (construction scripts in the editor) there is no game instance, so the table is loaded and the
+	 * row is found by name.
+	 * 
+	 * @param WorldContextObject Object used to find the game instance
+	 * @param Type Weapon type to get the row for
+	 * @return const FWeaponDataTable* Row, or nullptr if there is no row for the type
+	 */
+	static const FWeaponDataTable* FindWeaponData(const UObject* WorldContextObject, EWeaponType Type);
+
+	/**
+	 * @brief Gets the Item Rarity Data Table row from the subsystem of the game instance WorldContextObject is in
+	 * 
+	 * Outside of a game (construction scripts in the editor) there is no game instance, so the table is loaded and the
+	 * row is found by name.
+	 * 
+	 * @param WorldContextObject Object used to find the game instance
+	 * @param Rarity Item rarity to get the row for
+	 * @return const FItemRarityTable* Row, or nullptr if there is no row for the rarity
+	 */
+	static const FItemRarityTable* FindRarityData(const UObject* WorldContextObject, EItemRarity Rarity);
+
+	/**
+	 * @brief Gets the subsystem of the game instance WorldContextObject is in
+	 * 
+	 * @return UItemDataSubsystem* Subsystem, or nullptr if there is no game instance
+	 */
+	static UItemDataSubsystem* Get(const UObject* WorldContextObject);
+
+	/**
+	 * @brief Starts streaming in all assets of the weapon type, does nothing if they were already requested
+	 * 
+	 * @param Type Weapon type whose assets are about to be needed
+	 */
+	void RequestWeaponAssets(EWeaponType Type);
+
+	/**
+	 * @brief Starts streaming in the assets of every weapon type, used when the weapon type is not known yet
+	 * 
+	 */
+	void RequestAllWeaponAssets();
+
+	/**
+	 * @brief Gets the asset of a weapon row, loading it right away if it is not streamed in yet
+	 * 
+	 * @param Asset Soft reference from FWeaponDataTable
+	 * @return T* Loaded asset, or nullptr if the row has no asset set
+	 */
+	template<typename T>
+	static T* ResolveWeaponAsset(const TSoftObjectPtr<T>& Asset)
+	{
+		return Cast<T>(ResolveWeaponAssetPath(Asset.ToSoftObjectPath()));
+	}
+
+	/**
+	 * @brief Gets the class of a weapon row, loading it right away if it is not streamed in yet
+	 * 
+	 * @param Class Soft class reference from FWeaponDataTable
+	 * @return UClass* Loaded class, or nullptr if the row has no class set
+	 */
+	template<typename T>
+	static UClass* ResolveWeaponClass(const TSoftClassPtr<T>& Class)
+	{
+		return Cast<UClass>(ResolveWeaponAssetPath(Class.ToSoftObjectPath()));
+	}
+
+private:
+	/**
+	 * @brief Finds the asset at AssetPath if it is in memory, otherwise loads it synchronously
+	 * 
+	 * @param AssetPath Path of the asset
+	 * @return UObject* Asset, or nullptr if AssetPath is null or fails to load
+	 */
+	static UObject* ResolveWeaponAssetPath(const FSoftObjectPath& AssetPath);
+
+	/**
+	 * @brief Collects the paths of all soft referenced assets in the weapon row
+	 * 
+	 * @param Row Weapon row
+	 * @param OutAssetPaths Paths of the assets that are set in the row
+	 */
+	static void GetWeaponAssetPaths(const FWeaponDataTable& Row, TArray<FSoftObjectPath>& OutAssetPaths);
+
+	/**
+	 * @brief Called when the assets of the weapon type are streamed in, updates the resident memory stat of the type
+	 * 
+	 * @param Type Weapon type that finished streaming
+	 */
+	void OnWeaponAssetsLoaded(EWeaponType Type);
+
+	/**
+	 * @brief Sets the resident memory stat of the weapon type
+	 * 
+	 */
+	static void SetWeaponAssetMemoryStat(EWeaponType Type, int64 Bytes);
+
+	static UDataTable* LoadWeaponDataTable();
+	static UDataTable* LoadRarityDataTable();
+
+	//! Row names in the Data Tables for each enum value
+	static FName GetWeaponRowName(EWeaponType Type);
+	static FName GetRarityRowName(EItemRarity Rarity);
+
+	//! Kept referenced so the row pointers stay valid
+	UPROPERTY()
+	UDataTable* WeaponDataTable;
+
+	UPROPERTY()
+	UDataTable* RarityDataTable;
+
+	//! Rows indexed by EWeaponType
+	TArray<const FWeaponDataTable*> WeaponRows;
+
+	//! Rows indexed by EItemRarity
+	TArray<const FItemRarityTable*> RarityRows;
+
+	//! Streaming handles indexed by EWeaponType, keep the streamed assets resident
+	TArray<TSharedPtr<FStreamableHandle>> WeaponAssetHandles;
+};
@@ -0,0 +1,137 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+
+#include "LootPoolSubsystem.h"
+#include "Engine/World.h"
+#include "UltimateShooter/Weapons/Item.h"
+#include "UltimateShooter/UltimateShooter.h"
+
+DECLARE_DWORD_COUNTER_STAT(TEXT("Loot Spawn Requests"), STAT_LootSpawnRequests, STATGROUP_UltimateShooter);
+DECLARE_DWORD_COUNTER_STAT(TEXT("Loot Pool Hits"), STAT_LootPoolHits, STATGROUP_UltimateShooter);
+DECLARE_DWORD_COUNTER_STAT(TEXT("Loot Despawned Over Cap"), STAT_LootDespawnedOverCap, STATGROUP_UltimateShooter);
+DECLARE_FLOAT_ACCUMULATOR_STAT(TEXT("Loot Pool Hit Rate %"), STAT_LootPoolHitRate, STATGROUP_UltimateShooter);
+DECLARE_DWORD_ACCUMULATOR_STAT(TEXT("Pooled Loot"), STAT_PooledLoot, STATGROUP_UltimateShooter);
+DECLARE_DWORD_ACCUMULATOR_STAT(TEXT("Live Loot"), STAT_LiveLoot, STATGROUP_UltimateShooter);
+
+ULootPoolSubsystem::ULootPoolSubsystem() :
+	MaxLiveLoot{48},
+	MaxPooledPerClass{32},
+	SpawnRequests{0},
+	PoolHits{0}
+{
+}
+
+void ULootPoolSubsystem::Deinitialize()
+{
+	for (const auto& PoolPair : Pools)
+	{
+		DEC_DWORD_STAT_BY(STAT_PooledLoot, PoolPair.Value.Items.Num());
+	}
+	Pools.Empty();
+
+	DEC_DWORD_STAT_BY(STAT_LiveLoot, LiveLoot.Num());
+	LiveLoot.Empty();
+
+	Super::Deinitialize();
+}
+
+AItem* ULootPoolSubsystem::SpawnItem(TSubclassOf<AItem> ItemClass, const FVector& Location, const FRotator& Rotation)
+{
+	if (ItemClass == nullptr) return nullptr;
+
+	EnforceLiveLootCap();
+
+	SpawnRequests++;
+	INC_DWORD_STAT(STAT_LootSpawnRequests);
+
+	AItem* Item = nullptr;
+	if (FItemPool* Pool = Pools.Find(ItemClass))
+	{
+		while (Item == nullptr && Pool->Items.Num() > 0)
+		{
+			AItem* Parked = Pool->Items.Pop();
+			DEC_DWORD_STAT(STAT_PooledLoot);
+
+			if (IsValid(Parked))
+			{
+				Item = Parked;
+			}
+		}
+	}
+
+	if (Item)
+	{
+		PoolHits++;
+		INC_DWORD_STAT(STAT_LootPoolHits);
+		Item->ActivateFromPool(Location, Rotation);
+	}
+	else
+	{
+		Item = GetWorld()->SpawnActor<AItem>(ItemClass, Location, Rotation);
+	}
+	SET_FLOAT_STAT(STAT_LootPoolHitRate, GetHitRate());
+
+	if (Item)
+	{
+		LiveLoot.Add(Item);
+		INC_DWORD_STAT(STAT_LiveLoot);
+	}
+
+	return Item;
+}
+
+void ULootPoolSubsystem::ReleaseItem(AItem* Item)
+{
+	if (!IsValid(Item)) return;
+
+	ForgetItem(Item);
+
+	FItemPool& Pool = Pools.FindOrAdd(Item->GetClass());
+	if (Pool.Items.Num() >= MaxPooledPerClass)
+	{
+		Item->Destroy();
+		return;
+	}
+
+	Item->DeactivateForPool();
+	Pool.Items.Add(Item);
+	INC_DWORD_STAT(STAT_PooledLoot);
+}
+
+void ULootPoolSubsystem::ForgetItem(AItem* Item)
+{
+	if (LiveLoot.RemoveSingle(Item) > 0)
+	{
+		DEC_DWORD_STAT(STAT_LiveLoot);
+	}
+}
+
+float ULootPoolSubsystem::GetHitRate() const
+{
+	return SpawnRequests > 0 ? 100.f * PoolHits / SpawnRequests : 0.f;
+}
+
+ULootPoolSubsystem* ULootPoolSubsystem::Get(const UObject* WorldContextObject)
+{
+	UWorld* World = WorldContextObject ? WorldContextObject->GetWorld() : nullptr;
+	if (World == nullptr) return nullptr;
+
+	return World->GetSubsystem<ULootPoolSubsystem>();
+}
+
+void ULootPoolSubsystem::EnforceLiveLootCap()
+{
+	//! Picked up loot is forgotten by AItem::SetItemState, only destroyed loot is left to drop here
+	const int32 Removed = LiveLoot.RemoveAll([](const TWeakObjectPtr<AItem>& Loot) { return !Loot.IsValid(); });
+	DEC_DWORD_STAT_BY(STAT_LiveLoot, Removed);
+
+	while (LiveLoot.Num() >= MaxLiveLoot)
+	{
+		AItem* Oldest = LiveLoot[0].Get();
+		LiveLoot.RemoveAt(0);
+		DEC_DWORD_STAT(STAT_LiveLoot);
+
+		INC_DWORD_STAT(STAT_LootDespawnedOverCap);
+		ReleaseItem(Oldest);
+	}
+}
@@ -0,0 +1,112 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Subsystems/WorldSubsystem.h"
+#include "LootPoolSubsystem.generated.h"
+
+class AItem;
+
+//! Parked items of one class
+USTRUCT()
+struct FItemPool
+{
+	GENERATED_BODY()
+
+	UPROPERTY()
+	TArray<AItem*> Items;
+};
+
+/**
+ * @brief Reuses the weapon and ammo actors enemies drop instead of spawning and destroying them.
+ * 
+ * Picked up ammo and loot that is despawned is parked here per class. The number of loot items lying in the world is
+ * capped, once the cap is reached the oldest item that has not been picked up is despawned to make room.
+ */
+UCLASS()
+class ULTIMATESHOOTER_API ULootPoolSubsystem : public UWorldSubsystem
+{
+	GENERATED_BODY()
+
+public:
+	ULootPoolSubsystem();
+
+	/**
+	 * @brief Drops all parked items
+	 * 
+	 */
+	virtual void Deinitialize() override;
+
+	/**
+	 * @brief Reactivates a parked item of ItemClass, or spawns a new one if none is parked
+	 * 
+	 * Despawns the oldest loot first if the live loot cap is reached.
+	 * 
+	 * @param ItemClass Class of the item to spawn
+	 * @param Location Where the item is spawned
+	 * @param Rotation Rotation of the spawned item
+	 * @return AItem* Spawned item, or nullptr if ItemClass is not set
+	 */
+	AItem* SpawnItem(TSubclassOf<AItem> ItemClass, const FVector& Location, const FRotator& Rotation);
+
+	/**
+	 * @brief Typed SpawnItem
+	 * 
+	 */
+	template<typename T>
+	T* SpawnLoot(TSubclassOf<T> ItemClass, const FVector& Location, const FRotator& Rotation)
+	{
+		return Cast<T>(SpawnItem(ItemClass, Location, Rotation));
+	}
+
+	/**
+	 * @brief Parks the item for reuse, destroys it if the pool of its class is full
+	 * 
+	 * @param Item Item that was picked up or despawned
+	 */
+	void ReleaseItem(AItem* Item);
+
+	/**
+	 * @brief Stops counting the item as live loot, called when it leaves the Pickup and Falling states
+	 * 
+	 * @param Item Item that was picked up
+	 */
+	void ForgetItem(AItem* Item);
+
+	/**
+	 * @brief Percentage of SpawnItem calls that were served from the pool
+	 * 
+	 */
+	float GetHitRate() const;
+
+	/**
+	 * @brief Gets the loot pool of the world WorldContextObject is in
+	 * 
+	 * @return ULootPoolSubsystem* Subsystem, or nullptr if there is no world
+	 */
+	static ULootPoolSubsystem* Get(const UObject* WorldContextObject);
+
+private:
+	/**
+	 * @brief Forgets destroyed loot and despawns the oldest loot until there is room for one more item
+	 * 
+	 */
+	void EnforceLiveLootCap();
+
+	//! Parked items keyed by class
+	UPROPERTY()
+	TMap<UClass*, FItemPool> Pools;
+
+	//! Loot lying in the world, oldest first
+	TArray<TWeakObjectPtr<AItem>> LiveLoot;
+
+	//! Most loot items lying in the world at once
+	int32 MaxLiveLoot;
+
+	//! Items over this number per class are destroyed when released
+	int32 MaxPooledPerClass;
+
+	int32 SpawnRequests;
+	int32 PoolHits;
+};
@@ -0,0 +1,166 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+
+#include "SocketCacheSubsystem.h"
+#include "Engine/World.h"
+#include "Engine/GameInstance.h"
+#include "Engine/SkeletalMesh.h"
+#include "Engine/SkeletalMeshSocket.h"
+#include "Components/SkeletalMeshComponent.h"
+#include "UltimateShooter/UltimateShooter.h"
+
+DECLARE_DWORD_COUNTER_STAT(TEXT("Socket Cache Misses"), STAT_SocketCacheMisses, STATGROUP_UltimateShooter);
+DECLARE_DWORD_COUNTER_STAT(TEXT("Bone Cache Misses"), STAT_BoneCacheMisses, STATGROUP_UltimateShooter);
+DECLARE_DWORD_COUNTER_STAT(TEXT("Hit Zone Table Builds"), STAT_HitZoneTableBuilds, STATGROUP_UltimateShooter);
+
+const USkeletalMeshSocket* FCachedSocket::Get(const UObject* WorldContextObject, const USkeletalMeshComponent* Component, FName SocketName)
+{
+	const USkeletalMesh* ComponentMesh = Component ? Component->GetSkeletalMeshAsset() : nullptr;
+	if (ComponentMesh == nullptr) return nullptr;
+
+	if (Mesh.Get() != ComponentMesh || Name != SocketName)
+	{
+		Mesh = ComponentMesh;
+		Name = SocketName;
+		Socket = USocketCacheSubsystem::FindSocket(WorldContextObject, Component, SocketName);
+	}
+
+	return Socket;
+}
+
+int32 FCachedBone::Get(const UObject* WorldContextObject, const USkeletalMeshComponent* Component, FName BoneName)
+{
+	const USkeletalMesh* ComponentMesh = Component ? Component->GetSkeletalMeshAsset() : nullptr;
+	if (ComponentMesh == nullptr) return INDEX_NONE;
+
+	if (Mesh.Get() != ComponentMesh || Name != BoneName)
+	{
+		Mesh = ComponentMesh;
+		Name = BoneName;
+		BoneIndex = USocketCacheSubsystem::FindBoneIndex(WorldContextObject, Component, BoneName);
+	}
+
+	return BoneIndex;
+}
+
+void USocketCacheSubsystem::Deinitialize()
+{
+	Sockets.Empty();
+	Bones.Empty();
+	HitZones.Empty();
+
+	Super::Deinitialize();
+}
+
+const USkeletalMeshSocket* USocketCacheSubsystem::FindSocket(const UObject* WorldContextObject, const USkeletalMeshComponent* Component,
+	FName SocketName)
+{
+	if (Component == nullptr || SocketName.IsNone()) return nullptr;
+
+	const USkeletalMesh* MeshAsset = Component->GetSkeletalMeshAsset();
+	USocketCacheSubsystem* SocketCache = Get(WorldContextObject);
+	if (SocketCache == nullptr || MeshAsset == nullptr)
+	{
+		return Component->GetSocketByName(SocketName);
+	}
+
+	const TTuple<FObjectKey, FName> Key{ FObjectKey(MeshAsset), SocketName };
+	if (const TWeakObjectPtr<const USkeletalMeshSocket>* Socket = SocketCache->Sockets.Find(Key))
+	{
+		return Socket->Get();
+	}
+
+	INC_DWORD_STAT(STAT_SocketCacheMisses);
+	const USkeletalMeshSocket* Socket = Component->GetSocketByName(SocketName);
+	SocketCache->Sockets.Add(Key, Socket);
+	return Socket;
+}
+
+int32 USocketCacheSubsystem::FindBoneIndex(const UObject* WorldContextObject, const USkeletalMeshComponent* Component, FName BoneName)
+{
+	if (Component == nullptr || BoneName.IsNone()) return INDEX_NONE;
+
+	const USkeletalMesh* MeshAsset = Component->GetSkeletalMeshAsset();
+	USocketCacheSubsystem* SocketCache = Get(WorldContextObject);
+	if (SocketCache == nullptr || MeshAsset == nullptr)
+	{
+		return Component->GetBoneIndex(BoneName);
+	}
+
+	const TTuple<FObjectKey, FName> Key{ FObjectKey(MeshAsset), BoneName };
+	if (const int32* BoneIndex = SocketCache->Bones.Find(Key))
+	{
+		return *BoneIndex;
+	}
+
+	INC_DWORD_STAT(STAT_BoneCacheMisses);
+	const int32 BoneIndex = Component->GetBoneIndex(BoneName);
+	SocketCache->Bones.Add(Key, BoneIndex);
+	return BoneIndex;
+}
+
+TSharedPtr<const TArray<EHitZone>> USocketCacheSubsystem::FindHitZones(const UObject* WorldContextObject,
+	const USkeletalMeshComponent* Component, FName HeadBone, const TArray<FName>& LimbBones)
+{
+	const USkeletalMesh* MeshAsset = Component ? Component->GetSkeletalMeshAsset() : nullptr;
+	if (MeshAsset == nullptr) return nullptr;
+
+	USocketCacheSubsystem* SocketCache = Get(WorldContextObject);
+	if (SocketCache == nullptr)
+	{
+		return BuildHitZones(Component, HeadBone, LimbBones);
+	}
+
+	TArray<FHitZoneTable>& Tables = SocketCache->HitZones.FindOrAdd(FObjectKey(MeshAsset));
+	for (const FHitZoneTable& Table : Tables)
+	{
+		if (Table.HeadBone == HeadBone && Table.LimbBones == LimbBones)
+		{
+			return Table.Zones;
+		}
+	}
+
+	INC_DWORD_STAT(STAT_HitZoneTableBuilds);
+	TSharedPtr<const TArray<EHitZone>> Zones = BuildHitZones(Component, HeadBone, LimbBones);
+	Tables.Add({ HeadBone, LimbBones, Zones });
+	return Zones;
+}
+
+TSharedPtr<const TArray<EHitZone>> USocketCacheSubsystem::BuildHitZones(const USkeletalMeshComponent* Component, FName HeadBone,
+	const TArray<FName>& LimbBones)
+{
+	const int32 NumBones = Component->GetNumBones();
+	TSharedRef<TArray<EHitZone>> Zones = MakeShared<TArray<EHitZone>>();
+	Zones->Init(EHitZone::EHZ_Torso, NumBones);
+
+	//! Parents always come before their children, so every bone can take the zone of its parent
+	for (int32 BoneIndex = 0; BoneIndex < NumBones; BoneIndex++)
+	{
+		const FName BoneName = Component->GetBoneName(BoneIndex);
+		if (BoneName == HeadBone)
+		{
+			(*Zones)[BoneIndex] = EHitZone::EHZ_Head;
+		}
+		else if (LimbBones.Contains(BoneName))
+		{
+			(*Zones)[BoneIndex] = EHitZone::EHZ_Limb;
+		}
+		else
+		{
+			const int32 ParentIndex = Component->GetBoneIndex(Component->GetParentBone(BoneName));
+			if (Zones->IsValidIndex(ParentIndex))
+			{
+				(*Zones)[BoneIndex] = (*Zones)[ParentIndex];
+			}
+		}
+	}
+
+	return Zones;
+}
+
+USocketCacheSubsystem* USocketCacheSubsystem::Get(const UObject* WorldContextObject)
+{
+	const UWorld* World = WorldContextObject ? WorldContextObject->GetWorld() : nullptr;
+	const UGameInstance* GameInstance = World ? World->GetGameInstance() : nullptr;
+	return GameInstance ? GameInstance->GetSubsystem<USocketCacheSubsystem>() : nullptr;
+}
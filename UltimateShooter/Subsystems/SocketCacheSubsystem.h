@@ -0,0 +1,131 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Subsystems/GameInstanceSubsystem.h"
+#include "UObject/ObjectKey.h"
+#include "UltimateShooter/Enums/HitZone.h"
+#include "SocketCacheSubsystem.generated.h"
+
+class USkeletalMesh;
+class USkeletalMeshSocket;
+class USkeletalMeshComponent;
+
+//! Socket of a mesh asset, resolved again only when the component's mesh asset or the socket name changes
+struct FCachedSocket
+{
+	TWeakObjectPtr<const USkeletalMesh> Mesh;
+	FName Name;
+	const USkeletalMeshSocket* Socket = nullptr;
+
+	/**
+	 * @brief Gets the socket SocketName on the mesh asset of Component
+	 * 
+	 * @return const USkeletalMeshSocket* Socket, or nullptr if the mesh has no such socket
+	 */
+	const USkeletalMeshSocket* Get(const UObject* WorldContextObject, const USkeletalMeshComponent* Component, FName SocketName);
+};
+
+//! Bone index of a mesh asset, resolved again only when the component's mesh asset or the bone name changes
+struct FCachedBone
+{
+	TWeakObjectPtr<const USkeletalMesh> Mesh;
+	FName Name;
+	int32 BoneIndex = INDEX_NONE;
+
+	/**
+	 * @brief Gets the index of BoneName on the mesh asset of Component
+	 * 
+	 * @return int32 Bone index, or INDEX_NONE if the mesh has no such bone
+	 */
+	int32 Get(const UObject* WorldContextObject, const USkeletalMeshComponent* Component, FName BoneName);
+};
+
+/**
+ * @brief Resolves sockets and bones of skeletal mesh assets by name once per game.
+ * 
+ * Finding a socket by name searches every socket of the mesh and its skeleton. Here every mesh asset and name pair is
+ * searched once and the result is kept, FCachedSocket and FCachedBone then keep it on the actor so the hot paths do
+ * no lookup at all while the mesh does not change. Hit zone tables are built once per mesh asset the same way and
+ * shared by every enemy that uses it.
+ */
+UCLASS()
+class ULTIMATESHOOTER_API USocketCacheSubsystem : public UGameInstanceSubsystem
+{
+	GENERATED_BODY()
+
+public:
+	/**
+	 * @brief Drops every resolved socket and bone
+	 * 
+	 */
+	virtual void Deinitialize() override;
+
+	/**
+	 * @brief Gets the socket from the cache, resolving it on the first request for the mesh asset
+	 * 
+	 * Resolves by name without caching if there is no game instance.
+	 * 
+	 * @param WorldContextObject Object used to find the game instance
+	 * @param Component Mesh component whose asset has the socket
+	 * @param SocketName Name of the socket
+	 * @return const USkeletalMeshSocket* Socket, or nullptr if the mesh has no such socket
+	 */
+	static const USkeletalMeshSocket* FindSocket(const UObject* WorldContextObject, const USkeletalMeshComponent* Component, FName SocketName);
+
+	/**
+	 * @brief Gets the bone index from the cache, resolving it on the first request for the mesh asset
+	 * 
+	 * Resolves by name without caching if there is no game instance.
+	 * 
+	 * @param WorldContextObject Object used to find the game instance
+	 * @param Component Mesh component whose asset has the bone
+	 * @param BoneName Name of the bone
+	 * @return int32 Bone index, or INDEX_NONE if the mesh has no such bone
+	 */
+	static int32 FindBoneIndex(const UObject* WorldContextObject, const USkeletalMeshComponent* Component, FName BoneName);
+
+	/**
+	 * @brief Gets the hit zone of every bone of the mesh asset, building the table on the first request for the mesh asset
+	 * 
+	 * HeadBone and the bones under it are Head, bones under any of the LimbBones are Limb and the rest is Torso.
+	 * Builds the table without caching if there is no game instance.
+	 * 
+	 * @param WorldContextObject Object used to find the game instance
+	 * @param Component Mesh component whose asset has the bones
+	 * @param HeadBone Bone at the root of the Head zone
+	 * @param LimbBones Bones at the roots of the Limb zone
+	 * @return TSharedPtr<const TArray<EHitZone>> Hit zone of each bone indexed by bone index, nullptr if there is no mesh
+	 */
+	static TSharedPtr<const TArray<EHitZone>> FindHitZones(const UObject* WorldContextObject, const USkeletalMeshComponent* Component,
+		FName HeadBone, const TArray<FName>& LimbBones);
+
+	static USocketCacheSubsystem* Get(const UObject* WorldContextObject);
+
+private:
+	//! Resolved sockets by mesh asset and socket name, nullptr for sockets the mesh does not have
+	TMap<TTuple<FObjectKey, FName>, TWeakObjectPtr<const USkeletalMeshSocket>> Sockets;
+
+	//! Resolved bone indices by mesh asset and bone name, INDEX_NONE for bones the mesh does not have
+	TMap<TTuple<FObjectKey, FName>, int32> Bones;
+
+	//! Hit zone table of a mesh asset for one set of zone root bones
+	struct FHitZoneTable
+	{
+		FName HeadBone;
+		TArray<FName> LimbBones;
+		TSharedPtr<const TArray<EHitZone>> Zones;
+	};
+
+	//! Built hit zone tables by mesh asset, one per set of zone root bones used with the mesh
+	TMap<FObjectKey, TArray<FHitZoneTable>> HitZones;
+
+	/**
+	 * @brief Walks the bones of the mesh asset and resolves each of them to a hit zone
+	 * 
+	 * @return TSharedPtr<const TArray<EHitZone>> Hit zone of each bone indexed by bone index
+	 */
+	static TSharedPtr<const TArray<EHitZone>> BuildHitZones(const USkeletalMeshComponent* Component, FName HeadBone,
+		const TArray<FName>& LimbBones);
+};
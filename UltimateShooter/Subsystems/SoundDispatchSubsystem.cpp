@@ -0,0 +1,277 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+
+#include "SoundDispatchSubsystem.h"
+#include "Engine/World.h"
+#include "Kismet/GameplayStatics.h"
+#include "Components/AudioComponent.h"
+#include "Sound/SoundBase.h"
+#include "GameFramework/Pawn.h"
+#include "UltimateShooter/UltimateShooter.h"
+
+DECLARE_DWORD_ACCUMULATOR_STAT(TEXT("Active Voices Weapon Fire"), STAT_ActiveVoicesWeaponFire, STATGROUP_UltimateShooter);
+DECLARE_DWORD_ACCUMULATOR_STAT(TEXT("Active Voices Impact"), STAT_ActiveVoicesImpact, STATGROUP_UltimateShooter);
+DECLARE_DWORD_ACCUMULATOR_STAT(TEXT("Active Voices Melee"), STAT_ActiveVoicesMelee, STATGROUP_UltimateShooter);
+DECLARE_DWORD_ACCUMULATOR_STAT(TEXT("Active Voices Explosion"), STAT_ActiveVoicesExplosion, STATGROUP_UltimateShooter);
+DECLARE_DWORD_COUNTER_STAT(TEXT("Sound Requests Dropped"), STAT_SoundRequestsDropped, STATGROUP_UltimateShooter);
+DECLARE_DWORD_COUNTER_STAT(TEXT("Sound Requests Merged"), STAT_SoundRequestsMerged, STATGROUP_UltimateShooter);
+DECLARE_DWORD_COUNTER_STAT(TEXT("Sound Voices Stolen"), STAT_SoundVoicesStolen, STATGROUP_UltimateShooter);
+DECLARE_DWORD_COUNTER_STAT(TEXT("Audio Components Created"), STAT_AudioComponentsCreated, STATGROUP_UltimateShooter);
+
+USoundDispatchSubsystem::USoundDispatchSubsystem() :
+	MergeWindow{0.05f},
+	MergeDistance{200.f},
+	MaxPooledComponents{32}
+{
+	const int32 NumCategories = static_cast<int32>(ESoundCategory::ESC_MAX);
+	MaxVoices.Init(4, NumCategories);
+	MaxVoices[static_cast<int32>(ESoundCategory::ESC_Impact)] = 8;
+	MaxVoices[static_cast<int32>(ESoundCategory::ESC_Explosion)] = 3;
+
+	StealsOldestVoice.Init(false, NumCategories);
+	StealsOldestVoice[static_cast<int32>(ESoundCategory::ESC_WeaponFire)] = true;
+
+	ActiveVoices.SetNum(NumCategories);
+	RecentSounds.SetNum(NumCategories);
+}
+
+void USoundDispatchSubsystem::Tick(float DeltaTime)
+{
+	Super::Tick(DeltaTime);
+
+	const float Now = GetWorld()->GetTimeSeconds();
+
+	for (int32 i = 0; i < ActiveVoices.Num(); i++)
+	{
+		TArray<UAudioComponent*>& Voices = ActiveVoices[i];
+		const int32 NumVoices = Voices.Num();
+
+		for (int32 j = Voices.Num() - 1; j >= 0; j--)
+		{
+			UAudioComponent* Voice = Voices[j];
+			if (IsValid(Voice) && Voice->IsPlaying()) continue;
+
+			//! Keep the order, StealOldestVoice takes the first one
+			Voices.RemoveAt(j);
+			PlayingComponents.RemoveSingleSwap(Voice);
+
+			if (!IsValid(Voice)) continue;
+
+			if (FreeComponents.Num() < MaxPooledComponents)
+			{
+				FreeComponents.Add(Voice);
+			}
+			else
+			{
+				Voice->DestroyComponent();
+			}
+		}
+
+		if (Voices.Num() != NumVoices)
+		{
+			SetActiveVoiceStat(static_cast<ESoundCategory>(i));
+		}
+
+		RecentSounds[i].RemoveAllSwap([Now, this](const FRecentSound& Recent) { return Now - Recent.Time > MergeWindow; });
+	}
+}
+
+TStatId USoundDispatchSubsystem::GetStatId() const
+{
+	RETURN_QUICK_DECLARE_CYCLE_STAT(USoundDispatchSubsystem, STATGROUP_Tickables);
+}
+
+void USoundDispatchSubsystem::Deinitialize()
+{
+	for (int32 i = 0; i < ActiveVoices.Num(); i++)
+	{
+		for (UAudioComponent* Voice : ActiveVoices[i])
+		{
+			if (IsValid(Voice))
+			{
+				Voice->Stop();
+			}
+		}
+		ActiveVoices[i].Empty();
+		SetActiveVoiceStat(static_cast<ESoundCategory>(i));
+	}
+	PlayingComponents.Empty();
+	FreeComponents.Empty();
+
+	Super::Deinitialize();
+}
+
+void USoundDispatchSubsystem::PlaySound2D(const UObject* WorldContextObject, USoundBase* Sound, ESoundCategory Category)
+{
+	if (Sound == nullptr) return;
+
+	USoundDispatchSubsystem* SoundDispatch = Get(WorldContextObject);
+	if (SoundDispatch == nullptr)
+	{
+		UGameplayStatics::PlaySound2D(WorldContextObject, Sound);
+		return;
+	}
+
+	//! All 2D sounds share one location, merging would swallow the player's own rapid fire
+	const APawn* Pawn = Cast<APawn>(WorldContextObject);
+	const bool bCanMerge = Pawn == nullptr || !Pawn->IsLocallyControlled();
+
+	SoundDispatch->Dispatch(Sound, FVector::ZeroVector, Category, 1.f, false, bCanMerge);
+}
+
+void USoundDispatchSubsystem::PlaySoundAtLocation(const UObject* WorldContextObject, USoundBase* Sound, const FVector& Location,
+	ESoundCategory Category, float VolumeMultiplier)
+{
+	if (Sound == nullptr) return;
+
+	USoundDispatchSubsystem* SoundDispatch = Get(WorldContextObject);
+	if (SoundDispatch == nullptr)
+	{
+		UGameplayStatics::PlaySoundAtLocation(WorldContextObject, Sound, Location, VolumeMultiplier);
+		return;
+	}
+
+	SoundDispatch->Dispatch(Sound, Location, Category, VolumeMultiplier, true);
+}
+
+USoundDispatchSubsystem* USoundDispatchSubsystem::Get(const UObject* WorldContextObject)
+{
+	UWorld* World = WorldContextObject ? WorldContextObject->GetWorld() : nullptr;
+	if (World == nullptr) return nullptr;
+
+	return World->GetSubsystem<USoundDispatchSubsystem>();
+}
+
+int32 USoundDispatchSubsystem::GetActiveVoiceCount(ESoundCategory Category) const
+{
+	if (Category == ESoundCategory::ESC_MAX) return 0;
+
+	return ActiveVoices[static_cast<int32>(Category)].Num();
+}
+
+void USoundDispatchSubsystem::Dispatch(USoundBase* Sound, const FVector& Location, ESoundCategory Category, float VolumeMultiplier,
+	bool bSpatialized, bool bCanMerge)
+{
+	if (Category == ESoundCategory::ESC_MAX) return;
+	const int32 Index = static_cast<int32>(Category);
+
+	if (bCanMerge && IsMergedWithRecent(Sound, Location, Category))
+	{
+		INC_DWORD_STAT(STAT_SoundRequestsMerged);
+		return;
+	}
+
+	UAudioComponent* Voice{ nullptr };
+	if (ActiveVoices[Index].Num() >= MaxVoices[Index])
+	{
+		if (!StealsOldestVoice[Index])
+		{
+			INC_DWORD_STAT(STAT_SoundRequestsDropped);
+			return;
+		}
+
+		Voice = StealOldestVoice(Category);
+	}
+
+	if (Voice == nullptr)
+	{
+		Voice = AcquireComponent(Sound);
+	}
+	if (Voice == nullptr) return;
+
+	Voice->SetSound(Sound);
+	Voice->bAllowSpatialization = bSpatialized;
+	Voice->bIsUISound = false;
+	Voice->SetVolumeMultiplier(VolumeMultiplier);
+	if (bSpatialized)
+	{
+		Voice->SetWorldLocation(Location);
+	}
+	Voice->Play();
+
+	ActiveVoices[Index].Add(Voice);
+	PlayingComponents.Add(Voice);
+	SetActiveVoiceStat(Category);
+
+	FRecentSound& Recent = RecentSounds[Index].AddDefaulted_GetRef();
+	Recent.Sound = Sound;
+	Recent.Location = Location;
+	Recent.Time = GetWorld()->GetTimeSeconds();
+}
+
+bool USoundDispatchSubsystem::IsMergedWithRecent(USoundBase* Sound, const FVector& Location, ESoundCategory Category) const
+{
+	const float Now = GetWorld()->GetTimeSeconds();
+
+	for (const FRecentSound& Recent : RecentSounds[static_cast<int32>(Category)])
+	{
+		if (Recent.Sound == Sound && Now - Recent.Time <= MergeWindow &&
+			FVector::DistSquared(Recent.Location, Location) <= FMath::Square(MergeDistance))
+		{
+			return true;
+		}
+	}
+
+	return false;
+}
+
+UAudioComponent* USoundDispatchSubsystem::AcquireComponent(USoundBase* Sound)
+{
+	while (FreeComponents.Num() > 0)
+	{
+		UAudioComponent* Component = FreeComponents.Pop();
+		if (IsValid(Component))
+		{
+			return Component;
+		}
+	}
+
+	UAudioComponent* Component = UGameplayStatics::CreateSound2D(this, Sound, 1.f, 1.f, 0.f, nullptr, false, false);
+	if (Component)
+	{
+		INC_DWORD_STAT(STAT_AudioComponentsCreated);
+	}
+	return Component;
+}
+
+UAudioComponent* USoundDispatchSubsystem::StealOldestVoice(ESoundCategory Category)
+{
+	TArray<UAudioComponent*>& Voices = ActiveVoices[static_cast<int32>(Category)];
+
+	while (Voices.Num() > 0)
+	{
+		UAudioComponent* Voice = Voices[0];
+		Voices.RemoveAt(0);
+		PlayingComponents.RemoveSingleSwap(Voice);
+
+		if (IsValid(Voice))
+		{
+			INC_DWORD_STAT(STAT_SoundVoicesStolen);
+			Voice->Stop();
+			return Voice;
+		}
+	}
+
+	return nullptr;
+}
+
+void USoundDispatchSubsystem::SetActiveVoiceStat(ESoundCategory Category) const
+{
+	const int32 Count = GetActiveVoiceCount(Category);
+
+	switch (Category)
+	{
+	case ESoundCategory::ESC_WeaponFire:
+		SET_DWORD_STAT(STAT_ActiveVoicesWeaponFire, Count);
+		break;
+	case ESoundCategory::ESC_Impact:
+		SET_DWORD_STAT(STAT_ActiveVoicesImpact, Count);
+		break;
+	case ESoundCategory::ESC_Melee:
+		SET_DWORD_STAT(STAT_ActiveVoicesMelee, Count);
+		break;
+	case ESoundCategory::ESC_Explosion:
+		SET_DWORD_STAT(STAT_ActiveVoicesExplosion, Count);
+		break;
+	}
+}
@@ -0,0 +1,146 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Subsystems/WorldSubsystem.h"
+#include "UltimateShooter/Enums/SoundCategory.h"
+#include "SoundDispatchSubsystem.generated.h"
+
+class USoundBase;
+class UAudioComponent;
+
+//! Sound that was played recently, used to merge identical requests
+struct FRecentSound
+{
+	USoundBase* Sound = nullptr;
+	FVector Location = FVector::ZeroVector;
+	float Time = 0.f;
+};
+
+/**
+ * @brief Plays weapon, impact, melee and explosion sounds under a voice budget.
+ * 
+ * Each ESoundCategory has a limit on voices playing at once. Requests over the limit are dropped, except for weapon
+ * fire which stops its oldest voice to make room, so a gun never goes silent at full auto. A request for the same sound
+ * close to one played within MergeWindow seconds is merged into it, unless it is fired by the locally controlled pawn.
+ * Audio components are reused from a pool instead of being created for every sound.
+ */
+UCLASS()
+class ULTIMATESHOOTER_API USoundDispatchSubsystem : public UTickableWorldSubsystem
+{
+	GENERATED_BODY()
+
+public:
+	USoundDispatchSubsystem();
+
+	/**
+	 * @brief Returns finished voices to the pool and forgets sounds older than MergeWindow
+	 * 
+	 * @param DeltaTime The time elapsed since the last frame.
+	 */
+	virtual void Tick(float DeltaTime) override;
+
+	virtual TStatId GetStatId() const override;
+
+	/**
+	 * @brief Stops all voices and drops the pool
+	 * 
+	 */
+	virtual void Deinitialize() override;
+
+	/**
+	 * @brief Budgeted replacement for UGameplayStatics::PlaySound2D
+	 * 
+	 * Plays without a budget if the world has no sound dispatch. Sounds from a locally controlled pawn are never merged,
+	 * every 2D request shares the same location and the player has to hear each of their own shots.
+	 * 
+	 * @param WorldContextObject Object used to find the world
+	 * @param Sound Sound to play
+	 * @param Category Category whose voice limit applies
+	 */
+	static void PlaySound2D(const UObject* WorldContextObject, USoundBase* Sound, ESoundCategory Category);
+
+	/**
+	 * @brief Budgeted replacement for UGameplayStatics::PlaySoundAtLocation
+	 * 
+	 * Plays without a budget if the world has no sound dispatch.
+	 * 
+	 * @param WorldContextObject Object used to find the world
+	 * @param Sound Sound to play
+	 * @param Location Where the sound is played
+	 * @param Category Category whose voice limit applies
+	 * @param VolumeMultiplier Volume of the sound
+	 */
+	static void PlaySoundAtLocation(const UObject* WorldContextObject, USoundBase* Sound, const FVector& Location,
+		ESoundCategory Category, float VolumeMultiplier = 1.f);
+
+	/**
+	 * @brief Gets the sound dispatch of the world WorldContextObject is in
+	 * 
+	 * @return USoundDispatchSubsystem* Subsystem, or nullptr if there is no world
+	 */
+	static USoundDispatchSubsystem* Get(const UObject* WorldContextObject);
+
+	int32 GetActiveVoiceCount(ESoundCategory Category) const;
+
+private:
+	/**
+	 * @brief Applies merging and the voice limit, then plays the sound on a pooled audio component
+	 * 
+	 * @param bSpatialized false for 2D sounds
+	 * @param bCanMerge false plays the sound even if the same one was just played close by
+	 */
+	void Dispatch(USoundBase* Sound, const FVector& Location, ESoundCategory Category, float VolumeMultiplier,
+		bool bSpatialized, bool bCanMerge = true);
+
+	/**
+	 * @brief Checks if the same sound was played close to Location within MergeWindow
+	 * 
+	 */
+	bool IsMergedWithRecent(USoundBase* Sound, const FVector& Location, ESoundCategory Category) const;
+
+	/**
+	 * @brief Takes an audio component from the pool or creates a new one
+	 * 
+	 */
+	UAudioComponent* AcquireComponent(USoundBase* Sound);
+
+	/**
+	 * @brief Stops the oldest voice of the category and hands its audio component back
+	 * 
+	 * @return UAudioComponent* Stopped component, or nullptr if the category has no valid voice
+	 */
+	UAudioComponent* StealOldestVoice(ESoundCategory Category);
+
+	void SetActiveVoiceStat(ESoundCategory Category) const;
+
+	//! Voices playing at once per category, indexed by ESoundCategory
+	TArray<int32> MaxVoices;
+
+	//! true if a full category stops its oldest voice instead of dropping the request, indexed by ESoundCategory
+	TArray<bool> StealsOldestVoice;
+
+	//! Playing audio components per category, oldest first, indexed by ESoundCategory
+	TArray<TArray<UAudioComponent*>> ActiveVoices;
+
+	//! Sounds played in the last MergeWindow seconds per category, indexed by ESoundCategory
+	TArray<TArray<FRecentSound>> RecentSounds;
+
+	//! Finished audio components ready to be reused
+	UPROPERTY()
+	TArray<UAudioComponent*> FreeComponents;
+
+	//! Keeps playing components referenced, ActiveVoices is not visible to the garbage collector
+	UPROPERTY()
+	TArray<UAudioComponent*> PlayingComponents;
+
+	//! Seconds in which identical requests are merged
+	float MergeWindow;
+
+	//! Distance within which identical requests are merged
+	float MergeDistance;
+
+	//! Finished components over this number are destroyed
+	int32 MaxPooledComponents;
+};
@@ -0,0 +1,155 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+
+#include "Misc/AutomationTest.h"
+#include "UltimateShooter/Characters/Enemy.h"
+#include "UltimateShooter/Subsystems/DamagePipelineSubsystem.h"
+#include "UltimateShooter/Tests/TestWorld.h"
+
+#if WITH_DEV_AUTOMATION_TESTS
+
+namespace DamagePipelineTest
+{
+	FDamageRequest MakeRequest(uint32 TargetId, uint32 InstigatorId, float Amount)
+	{
+		FDamageRequest Request;
+		Request.TargetId = TargetId;
+		Request.InstigatorId = InstigatorId;
+		Request.CauserId = InstigatorId;
+		Request.Amount = Amount;
+		return Request;
+	}
+
+	struct FKillRecord
+	{
+		//! Causers in the order their damage was applied
+		TArray<int32> Applied;
+
+		//! Causer whose damage killed the enemy, INDEX_NONE if it survived
+		int32 Killer = INDEX_NONE;
+	};
+
+	/**
+	 * @brief Queues Hits on a new enemy through the damage pipeline of World and resolves them in one frame
+	 * 
+	 * @param Hits Causer index and amount of each hit, in queue order
+	 */
+	FKillRecord ResolveHits(UWorld* World, const TArray<AActor*>& Causers, const TArray<TPair<int32, float>>& Hits)
+	{
+		FKillRecord Record;
+
+		AEnemy* Enemy = World->SpawnActor<AEnemy>();
+		UDamagePipelineSubsystem* Pipeline = World->GetSubsystem<UDamagePipelineSubsystem>();
+		if (Enemy == nullptr || Pipeline == nullptr) return Record;
+
+		for (const TPair<int32, float>& Hit : Hits)
+		{
+			const int32 CauserIndex = Hit.Key;
+			UDamagePipelineSubsystem::QueueDamage(World, Enemy, Hit.Value, nullptr, Causers[CauserIndex],
+				[&Record, Enemy, CauserIndex]()
+				{
+					Record.Applied.Add(CauserIndex);
+					if (Record.Killer == INDEX_NONE && Enemy->IsDead())
+					{
+						Record.Killer = CauserIndex;
+					}
+				});
+		}
+
+		Pipeline->Tick(0.f);
+		return Record;
+	}
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FDamagePipelineOrderTest, "UltimateShooter.DamagePipeline.Ordering",
+	EAutomationTestFlags::ApplicationContextMask | EAutomationTestFlags::ProductFilter)
+
+bool FDamagePipelineOrderTest::RunTest(const FString& Parameters)
+{
+	using namespace DamagePipelineTest;
+
+	TArray<FDamageRequest> Requests;
+	Requests.Add(MakeRequest(3, 1, 10.f));
+	Requests.Add(MakeRequest(1, 2, 20.f));
+	Requests.Add(MakeRequest(3, 2, 30.f));
+	Requests.Add(MakeRequest(2, 1, 40.f));
+	Requests.Add(MakeRequest(3, 2, 50.f));
+	Requests.Add(MakeRequest(1, 2, 60.f));
+
+	const int32 NumMerged = DamagePipeline::SortAndMerge(Requests);
+
+	TestEqual(TEXT("Merged count"), NumMerged, 2);
+	if (!TestEqual(TEXT("Request count"), Requests.Num(), 4)) return false;
+
+	//! Targets come out sorted, each target keeps its queue order
+	TestEqual(TEXT("Target 1"), static_cast<int32>(Requests[0].TargetId), 1);
+	TestEqual(TEXT("Target 1 merged amount"), Requests[0].Amount, 80.f);
+	TestEqual(TEXT("Target 2"), static_cast<int32>(Requests[1].TargetId), 2);
+	TestEqual(TEXT("Target 3 first request"), static_cast<int32>(Requests[2].InstigatorId), 1);
+	TestEqual(TEXT("Target 3 first amount"), Requests[2].Amount, 10.f);
+	TestEqual(TEXT("Target 3 second request"), static_cast<int32>(Requests[3].InstigatorId), 2);
+	TestEqual(TEXT("Target 3 merged amount"), Requests[3].Amount, 80.f);
+
+	return true;
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FDamagePipelineMergeTest, "UltimateShooter.DamagePipeline.MergeKeepsHitNumber",
+	EAutomationTestFlags::ApplicationContextMask | EAutomationTestFlags::ProductFilter)
+
+bool FDamagePipelineMergeTest::RunTest(const FString& Parameters)
+{
+	using namespace DamagePipelineTest;
+
+	TArray<FDamageRequest> Requests;
+	Requests.Add(MakeRequest(1, 1, 10.f));
+	Requests.Last().bShowHitNumber = true;
+	Requests.Last().bHeadShot = true;
+	Requests.Last().HitLocation = FVector(1.f, 0.f, 0.f);
+	Requests.Add(MakeRequest(1, 1, 5.f));
+	Requests.Last().bShowHitNumber = true;
+	Requests.Last().HitLocation = FVector(2.f, 0.f, 0.f);
+	Requests.Add(MakeRequest(1, 1, 1.f));
+
+	DamagePipeline::SortAndMerge(Requests);
+
+	if (!TestEqual(TEXT("Request count"), Requests.Num(), 1)) return false;
+
+	TestEqual(TEXT("Amount"), Requests[0].Amount, 16.f);
+	TestTrue(TEXT("Shows Hit Number"), Requests[0].bShowHitNumber);
+	TestTrue(TEXT("Any headshot makes a headshot"), Requests[0].bHeadShot);
+	TestEqual(TEXT("Last Hit Number location"), Requests[0].HitLocation, FVector(2.f, 0.f, 0.f));
+
+	return true;
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FDamagePipelineKillTest, "UltimateShooter.DamagePipeline.KillAttribution",
+	EAutomationTestFlags::ApplicationContextMask | EAutomationTestFlags::ProductFilter)
+
+bool FDamagePipelineKillTest::RunTest(const FString& Parameters)
+{
+	using namespace DamagePipelineTest;
+
+	const FTestWorld World;
+
+	//! Players are told apart by the causer, index 0 is unused
+	TArray<AActor*> Causers{ nullptr, World->SpawnActor<AActor>(), World->SpawnActor<AActor>() };
+	if (!TestNotNull(TEXT("Damage pipeline"), World->GetSubsystem<UDamagePipelineSubsystem>()) ||
+		!TestNotNull(TEXT("Causer 1"), Causers[1]) || !TestNotNull(TEXT("Causer 2"), Causers[2]))
+	{
+		return false;
+	}
+
+	//! Player 1 lands the killing blow after player 2's hit, merging must not move it in front, the last hit is dropped
+	FKillRecord Record = ResolveHits(World.Get(), Causers, { { 1, 60.f }, { 2, 30.f }, { 1, 20.f }, { 2, 5.f } });
+	TestEqual(TEXT("Applied hits"), Record.Applied, TArray<int32>{ 1, 2, 1 });
+	TestEqual(TEXT("Killer"), Record.Killer, 1);
+
+	//! Consecutive hits from one player merge, the next player still gets the kill
+	Record = ResolveHits(World.Get(), Causers, { { 1, 60.f }, { 1, 30.f }, { 2, 20.f } });
+	TestEqual(TEXT("Applied hits after merge"), Record.Applied, TArray<int32>{ 1, 1, 2 });
+	TestEqual(TEXT("Kill credited after merge"), Record.Killer, 2);
+
+	return true;
+}
+
+#endif
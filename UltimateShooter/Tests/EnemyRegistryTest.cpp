@@ -0,0 +1,135 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+
+#include "Misc/AutomationTest.h"
+#include "HAL/PlatformTime.h"
+#include "Engine/DamageEvents.h"
+#include "UltimateShooter/Characters/Enemy.h"
+#include "UltimateShooter/Characters/EnemyController.h"
+#include "UltimateShooter/GameModes/KillEmAllGameMode.h"
+#include "UltimateShooter/Tests/TestWorld.h"
+
+#if WITH_DEV_AUTOMATION_TESTS
+
+namespace EnemyRegistryTest
+{
+	constexpr int32 NumEnemies{ 1000 };
+
+	//! Enemies unpossessed and possessed again before the kills
+	constexpr int32 NumRepossessed{ 10 };
+
+	//! More than any enemy has, TakeDamage kills with it
+	constexpr float LethalDamage{ 1'000'000.f };
+
+	const FName EnemyTypes[] = { FName(TEXT("Grux")), FName(TEXT("Minion")), FName(TEXT("Khaimera")), FName(TEXT("Other")) };
+
+	//! Archetype types the names above build, indexed like EnemyTypes
+	const EEnemyType ArchetypeTypes[] = { EEnemyType::EET_Grux, EEnemyType::EET_Minion, EEnemyType::EET_Khaimera, EEnemyType::EET_Other };
+
+	//! EnemyType is only set in the editor, the test writes it through reflection
+	void SetEnemyType(AEnemy* Enemy, FName EnemyType)
+	{
+		FNameProperty* Property = FindFProperty<FNameProperty>(AEnemy::StaticClass(), TEXT("EnemyType"));
+		if (Property)
+		{
+			Property->SetPropertyValue_InContainer(Enemy, EnemyType);
+		}
+	}
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FEnemyRegistryThousandKillsTest, "UltimateShooter.EnemyRegistry.ThousandKills",
+	EAutomationTestFlags::ApplicationContextMask | EAutomationTestFlags::ProductFilter)
+
+bool FEnemyRegistryThousandKillsTest::RunTest(const FString& Parameters)
+{
+	using namespace EnemyRegistryTest;
+
+	const FTestWorld World;
+
+	//! AEnemy::Die and AEnemyController find it as the authority game mode
+	AKillEmAllGameMode* GameMode = World.SpawnGameMode<AKillEmAllGameMode>();
+	if (!TestNotNull(TEXT("Game mode"), GameMode))
+	{
+		return false;
+	}
+
+	TArray<AEnemy*> Enemies;
+	TArray<AEnemyController*> Controllers;
+	Enemies.Reserve(NumEnemies);
+	Controllers.Reserve(NumEnemies);
+	for (int32 i = 0; i < NumEnemies; i++)
+	{
+		AEnemy* Enemy = World->SpawnActor<AEnemy>();
+		AEnemyController* Controller = World->SpawnActor<AEnemyController>();
+		if (Enemy == nullptr || Controller == nullptr) continue;
+
+		SetEnemyType(Enemy, EnemyTypes[i % UE_ARRAY_COUNT(EnemyTypes)]);
+		Enemies.Add(Enemy);
+		Controllers.Add(Controller);
+	}
+	if (!TestEqual(TEXT("Spawned enemies"), Enemies.Num(), NumEnemies))
+	{
+		return false;
+	}
+
+	const double StartTime = FPlatformTime::Seconds();
+
+	//! AEnemyController::OnPossess registers the enemy
+	for (int32 i = 0; i < Enemies.Num(); i++)
+	{
+		Controllers[i]->Possess(Enemies[i]);
+	}
+
+	TestEqual(TEXT("Live enemies after possessing"), GameMode->GetLiveEnemyCount(), Enemies.Num());
+	for (int32 Type = 0; Type < UE_ARRAY_COUNT(EnemyTypes); Type++)
+	{
+		TestEqual(*FString::Printf(TEXT("Live %s after possessing"), *EnemyTypes[Type].ToString()),
+			GameMode->GetLiveEnemyCountByType(ArchetypeTypes[Type]), Enemies.Num() / static_cast<int32>(UE_ARRAY_COUNT(EnemyTypes)));
+	}
+
+	//! AEnemyController::OnUnPossess unregisters an enemy that leaves play without dying, possessing it again counts it again
+	for (int32 i = 0; i < NumRepossessed; i++)
+	{
+		Controllers[i]->UnPossess();
+	}
+	TestEqual(TEXT("Live enemies after unpossessing"), GameMode->GetLiveEnemyCount(), Enemies.Num() - NumRepossessed);
+	for (int32 i = 0; i < NumRepossessed; i++)
+	{
+		Controllers[i]->Possess(Enemies[i]);
+	}
+	TestEqual(TEXT("Live enemies after possessing again"), GameMode->GetLiveEnemyCount(), Enemies.Num());
+
+	//! AEnemy::Die unregisters the enemy before reporting the kill
+	bool bEndedEarly{ false };
+	for (int32 i = 0; i < Enemies.Num(); i++)
+	{
+		Enemies[i]->TakeDamage(LethalDamage, FDamageEvent(), nullptr, nullptr);
+
+		if (i < Enemies.Num() - 1 && GameMode->HasGameEnded())
+		{
+			bEndedEarly = true;
+		}
+	}
+
+	const double ElapsedMs = (FPlatformTime::Seconds() - StartTime) * 1000.0;
+
+	TestFalse(TEXT("No victory before the last kill"), bEndedEarly);
+	TestTrue(TEXT("Last kill ends the game"), GameMode->HasGameEnded());
+	TestTrue(TEXT("Player wins"), GameMode->IsPlayerWinner());
+	TestEqual(TEXT("Live enemies after killing"), GameMode->GetLiveEnemyCount(), 0);
+	for (int32 Type = 0; Type < UE_ARRAY_COUNT(EnemyTypes); Type++)
+	{
+		TestEqual(*FString::Printf(TEXT("Live %s after killing"), *EnemyTypes[Type].ToString()),
+			GameMode->GetLiveEnemyCountByType(ArchetypeTypes[Type]), 0);
+	}
+
+	//! Dead enemies are already unregistered, unpossessing them changes nothing
+	Controllers[0]->UnPossess();
+	TestEqual(TEXT("Live enemies after unpossessing a dead enemy"), GameMode->GetLiveEnemyCount(), 0);
+
+	AddInfo(FString::Printf(TEXT("Possessed and killed %d enemies in %.3f ms"), Enemies.Num(), ElapsedMs));
+
+	return true;
+}
+
+#endif
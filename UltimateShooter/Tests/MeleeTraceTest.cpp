@@ -0,0 +1,243 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+
+#include "Misc/AutomationTest.h"
+#include "GameFramework/Character.h"
+#include "Components/SkeletalMeshComponent.h"
+#include "UltimateShooter/Components/MeleeTraceComponent.h"
+#include "UltimateShooter/Tests/TestWorld.h"
+
+#if WITH_DEV_AUTOMATION_TESTS
+
+namespace MeleeTraceTest
+{
+	//! Defaults of UMeleeTraceComponent
+	constexpr float SubStepRate{ 120.f };
+	constexpr int32 MaxSubSteps{ 12 };
+	constexpr float TraceRadius{ 20.f };
+
+	//! A 90 degree swing of a socket 100 units from the pivot
+	constexpr float SwingTime{ 0.2f };
+	constexpr float SwingRadius{ 100.f };
+	constexpr float SwingAngle{ 90.f };
+
+	const float FrameRates[] = { 20.f, 60.f, 144.f };
+
+	//! Swings of the world test, alternating direction so each one crosses the target once
+	constexpr int32 NumSwings{ 4 };
+
+	//! Reach of the attacker in the world test, wide enough that a frame at 20 fps moves past the whole target
+	constexpr float AttackerReach{ 300.f };
+
+	FVector GetArcLocation(float Time)
+	{
+		const float Angle = FMath::DegreesToRadians(SwingAngle * FMath::Clamp(Time / SwingTime, 0.f, 1.f));
+		return FVector(FMath::Cos(Angle), FMath::Sin(Angle), 0.f) * SwingRadius;
+	}
+
+	FTransform GetTurnTransform(float Time)
+	{
+		return FTransform(FRotator(0.f, SwingAngle * FMath::Clamp(Time / SwingTime, 0.f, 1.f), 0.f));
+	}
+
+	/**
+	 * @brief Joins the sweep paths of every frame of a swing sampled at FrameRate
+	 *
+	 * @param LocalAt Component space socket location at a time
+	 * @param TransformAt Mesh transform at a time
+	 */
+	TArray<FVector> BuildPath(float FrameRate, TFunctionRef<FVector(float)> LocalAt, TFunctionRef<FTransform(float)> TransformAt)
+	{
+		const float DeltaTime = 1.f / FrameRate;
+		const int32 NumSubSteps = MeleeTrace::GetNumSubSteps(DeltaTime, SubStepRate, MaxSubSteps);
+
+		TArray<FVector> Path;
+		TArray<FVector> FramePath;
+
+		float LastTime{ 0.f };
+		while (LastTime < SwingTime)
+		{
+			const float Time = FMath::Min(LastTime + DeltaTime, SwingTime);
+			MeleeTrace::BuildSubStepPath(TransformAt(LastTime), LocalAt(LastTime), TransformAt(Time), LocalAt(Time), NumSubSteps, FramePath);
+
+			//! Each frame starts where the last one ended
+			for (int32 i = Path.Num() > 0 ? 1 : 0; i < FramePath.Num(); i++)
+			{
+				Path.Add(FramePath[i]);
+			}
+
+			LastTime = Time;
+		}
+
+		return Path;
+	}
+
+	float GetDistanceToPath(const TArray<FVector>& Path, const FVector& Point)
+	{
+		float Distance{ TNumericLimits<float>::Max() };
+		for (int32 i = 1; i < Path.Num(); i++)
+		{
+			Distance = FMath::Min(Distance, static_cast<float>(FMath::PointDistToSegment(Point, Path[i - 1], Path[i])));
+		}
+		return Distance;
+	}
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FMeleeTraceSubStepTest, "UltimateShooter.MeleeTrace.SubSteps",
+	EAutomationTestFlags::ApplicationContextMask | EAutomationTestFlags::ProductFilter)
+
+bool FMeleeTraceSubStepTest::RunTest(const FString& Parameters)
+{
+	using namespace MeleeTraceTest;
+
+	TestEqual(TEXT("20 fps"), MeleeTrace::GetNumSubSteps(1.f / 20.f, SubStepRate, MaxSubSteps), 6);
+	TestEqual(TEXT("60 fps"), MeleeTrace::GetNumSubSteps(1.f / 60.f, SubStepRate, MaxSubSteps), 2);
+	TestEqual(TEXT("144 fps"), MeleeTrace::GetNumSubSteps(1.f / 144.f, SubStepRate, MaxSubSteps), 1);
+	TestEqual(TEXT("Hitch is clamped"), MeleeTrace::GetNumSubSteps(0.5f, SubStepRate, MaxSubSteps), MaxSubSteps);
+	TestEqual(TEXT("Paused frame still sweeps once"), MeleeTrace::GetNumSubSteps(0.f, SubStepRate, MaxSubSteps), 1);
+
+	//! Sub-steps of one frame run from the last sample to the current one
+	const FTransform Last(FRotator(0.f, 0.f, 0.f), FVector(0.f, 0.f, 0.f));
+	const FTransform Current(FRotator(0.f, 90.f, 0.f), FVector(50.f, 0.f, 0.f));
+	const FVector LastLocal(100.f, 0.f, 0.f);
+	const FVector CurrentLocal(100.f, 0.f, 50.f);
+	TestEqual(TEXT("Alpha 0 is the last sample"), MeleeTrace::GetSubStepLocation(Last, LastLocal, Current, CurrentLocal, 0.f),
+		Last.TransformPosition(LastLocal));
+	TestEqual(TEXT("Alpha 1 is the current sample"), MeleeTrace::GetSubStepLocation(Last, LastLocal, Current, CurrentLocal, 1.f),
+		Current.TransformPosition(CurrentLocal));
+
+	TArray<FVector> Path;
+	MeleeTrace::BuildSubStepPath(Last, LastLocal, Current, CurrentLocal, 4, Path);
+	if (!TestEqual(TEXT("Path points"), Path.Num(), 5)) return false;
+	TestEqual(TEXT("Path starts at the last sample"), Path[0], Last.TransformPosition(LastLocal));
+	TestEqual(TEXT("Path middle"), Path[2], MeleeTrace::GetSubStepLocation(Last, LastLocal, Current, CurrentLocal, 0.5f));
+	TestEqual(TEXT("Path ends at the current sample"), Path[4], Current.TransformPosition(CurrentLocal));
+
+	MeleeTrace::BuildSubStepPath(Last, LastLocal, Current, CurrentLocal, 0, Path);
+	TestEqual(TEXT("No sub-steps still sweeps once"), Path.Num(), 2);
+
+	return true;
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FMeleeTraceSwingPathTest, "UltimateShooter.MeleeTrace.SwingPathMatchesAcrossFrameRates",
+	EAutomationTestFlags::ApplicationContextMask | EAutomationTestFlags::ProductFilter)
+
+bool FMeleeTraceSwingPathTest::RunTest(const FString& Parameters)
+{
+	using namespace MeleeTraceTest;
+
+	//! Target on the arc, between the frame samples at every tested frame rate
+	const FVector Target = GetArcLocation(SwingTime * 0.37f);
+
+	for (const float FrameRate : FrameRates)
+	{
+		//! The socket swings while the owner stands still, the path between frames is the chord of the arc
+		const TArray<FVector> Path = BuildPath(FrameRate, &GetArcLocation, [](float) { return FTransform::Identity; });
+
+		const FString Context = FString::Printf(TEXT("%.0f fps"), FrameRate);
+		TestEqual(*(Context + TEXT(" starts at the first sample")), Path[0], GetArcLocation(0.f));
+		TestEqual(*(Context + TEXT(" ends at the last sample")), Path.Last(), GetArcLocation(SwingTime));
+		TestTrue(*(Context + TEXT(" sweeps through the target")), GetDistanceToPath(Path, Target) <= TraceRadius);
+	}
+
+	return true;
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FMeleeTraceOwnerTurnTest, "UltimateShooter.MeleeTrace.OwnerTurnMatchesAcrossFrameRates",
+	EAutomationTestFlags::ApplicationContextMask | EAutomationTestFlags::ProductFilter)
+
+bool FMeleeTraceOwnerTurnTest::RunTest(const FString& Parameters)
+{
+	using namespace MeleeTraceTest;
+
+	for (const float FrameRate : FrameRates)
+	{
+		//! The socket is held still while the owner turns, sub-steps keep the sweeps on the arc at every frame rate
+		const TArray<FVector> Path = BuildPath(FrameRate, [](float) { return FVector(SwingRadius, 0.f, 0.f); }, &GetTurnTransform);
+
+		float MaxDeviation{ 0.f };
+		for (int32 i = 1; i < Path.Num(); i++)
+		{
+			const FVector Middle = (Path[i - 1] + Path[i]) * 0.5f;
+			MaxDeviation = FMath::Max(MaxDeviation, SwingRadius - static_cast<float>(Middle.Size()));
+		}
+
+		const FString Context = FString::Printf(TEXT("%.0f fps"), FrameRate);
+		TestEqual(*(Context + TEXT(" ends at the last sample")), Path.Last(), GetTurnTransform(SwingTime).TransformPosition(FVector(SwingRadius, 0.f, 0.f)));
+		TestTrue(*(Context + TEXT(" stays on the arc")), MaxDeviation <= 0.1f);
+	}
+
+	return true;
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FMeleeTraceOneHitPerSwingTest, "UltimateShooter.MeleeTrace.OneHitPerSwing",
+	EAutomationTestFlags::ApplicationContextMask | EAutomationTestFlags::ProductFilter)
+
+bool FMeleeTraceOneHitPerSwingTest::RunTest(const FString& Parameters)
+{
+	using namespace MeleeTraceTest;
+
+	const FTestWorld World;
+
+	//! Target stands on the arc the attacker's reach sweeps while it turns, between the frame samples
+	const FVector TargetLocation = GetTurnTransform(SwingTime * 0.37f).TransformPosition(FVector(AttackerReach, 0.f, 0.f));
+	ACharacter* Attacker = World->SpawnActor<ACharacter>();
+	ACharacter* Target = World->SpawnActor<ACharacter>(TargetLocation, FRotator::ZeroRotator);
+	if (!TestNotNull(TEXT("Attacker"), Attacker) || !TestNotNull(TEXT("Target"), Target))
+	{
+		return false;
+	}
+
+	//! The mesh has no asset, so the traced socket is the mesh origin, held out at the attacker's reach
+	Attacker->GetMesh()->SetRelativeLocation(FVector(AttackerReach, 0.f, 0.f));
+	UMeleeTraceComponent* Trace = NewObject<UMeleeTraceComponent>(Attacker);
+	Trace->RegisterComponent();
+	//! Play is never begun, BeginPlay is where the component finds the attacker's mesh
+	Attacker->DispatchBeginPlay();
+
+	int32 NumHits{ 0 };
+	AActor* LastVictim{ nullptr };
+	Trace->OnMeleeHit.AddLambda([&NumHits, &LastVictim](AActor* Victim, FName SocketName, const FHitResult& Hit)
+	{
+		NumHits++;
+		LastVictim = Victim;
+	});
+
+	const FName SocketName(TEXT("WeaponSocket"));
+	for (const float FrameRate : FrameRates)
+	{
+		const float DeltaTime = 1.f / FrameRate;
+
+		for (int32 Swing = 0; Swing < NumSwings; Swing++)
+		{
+			const bool bBackswing = Swing % 2 == 1;
+			const auto GetSwingRotation = [bBackswing](float Time) { return GetTurnTransform(bBackswing ? SwingTime - Time : Time).Rotator(); };
+
+			NumHits = 0;
+			LastVictim = nullptr;
+			Attacker->SetActorRotation(GetSwingRotation(0.f));
+			Trace->BeginSwing(SocketName);
+
+			float LastTime{ 0.f };
+			while (LastTime < SwingTime)
+			{
+				const float Time = FMath::Min(LastTime + DeltaTime, SwingTime);
+				Attacker->SetActorRotation(GetSwingRotation(Time));
+				Trace->TickComponent(DeltaTime, ELevelTick::LEVELTICK_All, nullptr);
+				LastTime = Time;
+			}
+
+			//! The weapon rests past the target for a frame, an actor is reported once per swing
+			Trace->TickComponent(DeltaTime, ELevelTick::LEVELTICK_All, nullptr);
+			Trace->EndSwing(SocketName);
+
+			const FString Context = FString::Printf(TEXT("%.0f fps swing %d"), FrameRate, Swing + 1);
+			TestEqual(*(Context + TEXT(" hits")), NumHits, 1);
+			TestTrue(*(Context + TEXT(" hits the target")), LastVictim == Target);
+		}
+	}
+
+	return true;
+}
+
+#endif
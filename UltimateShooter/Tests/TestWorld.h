@@ -0,0 +1,63 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Engine/Engine.h"
+#include "Engine/World.h"
+#include "GameFramework/GameModeBase.h"
+
+#if WITH_DEV_AUTOMATION_TESTS
+
+/**
+ * @brief Game world for automation tests, destroyed when it goes out of scope.
+ *
+ * Play is never begun, so actors spawn without running BeginPlay and need no assets. Tests that need BeginPlay call
+ * it on the actors themselves.
+ */
+class FTestWorld
+{
+public:
+	FTestWorld()
+		: World{ UWorld::CreateWorld(EWorldType::Game, false) }
+	{
+		FWorldContext& WorldContext = GEngine->CreateNewWorldContext(EWorldType::Game);
+		WorldContext.SetCurrentWorld(World);
+	}
+
+	~FTestWorld()
+	{
+		GEngine->DestroyWorldContext(World);
+		World->DestroyWorld(false);
+	}
+
+	FTestWorld(const FTestWorld&) = delete;
+	FTestWorld& operator=(const FTestWorld&) = delete;
+
+	/**
+	 * @brief Spawns a game mode and makes it the authority game mode of the world, like loading a map would
+	 * 
+	 * AuthorityGameMode can only be set by loading a map, the test world writes it through reflection.
+	 * 
+	 * @return T* Game mode, or nullptr if it could not be spawned
+	 */
+	template<typename T>
+	T* SpawnGameMode() const
+	{
+		T* GameMode = World->SpawnActor<T>();
+		FObjectPropertyBase* Property = FindFProperty<FObjectPropertyBase>(UWorld::StaticClass(), TEXT("AuthorityGameMode"));
+		if (GameMode && Property)
+		{
+			Property->SetObjectPropertyValue_InContainer(World, GameMode);
+		}
+		return World->GetAuthGameMode() == GameMode ? GameMode : nullptr;
+	}
+
+	FORCEINLINE UWorld* Get() const { return World; }
+	FORCEINLINE UWorld* operator->() const { return World; }
+
+private:
+	UWorld* World;
+};
+
+#endif
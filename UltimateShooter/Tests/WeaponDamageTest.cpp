@@ -0,0 +1,91 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+
+#include "Misc/AutomationTest.h"
+#include "UltimateShooter/Weapons/WeaponDamage.h"
+
+#if WITH_DEV_AUTOMATION_TESTS
+
+namespace WeaponDamageTest
+{
+	struct FExpectedDamage
+	{
+		EWeaponType Type;
+		EItemRarity Rarity;
+		FWeaponDamageValues Values;
+	};
+
+	//! Damage that used to be hardcoded in AWeapon::SetWeaponDamage
+	const FExpectedDamage ExpectedDamage[] =
+	{
+		{ EWeaponType::EWT_Pistol, EItemRarity::EIR_Damaged, { 10.f, 15.f } },
+		{ EWeaponType::EWT_Pistol, EItemRarity::EIR_Common, { 12.f, 17.f } },
+		{ EWeaponType::EWT_Pistol, EItemRarity::EIR_Uncommon, { 14.f, 20.f } },
+		{ EWeaponType::EWT_Pistol, EItemRarity::EIR_Rare, { 15.f, 25.f } },
+		{ EWeaponType::EWT_Pistol, EItemRarity::EIR_Legendary, { 50.f, 100.f } },
+
+		{ EWeaponType::EWT_SubmachineGun, EItemRarity::EIR_Damaged, { 11.f, 16.f } },
+		{ EWeaponType::EWT_SubmachineGun, EItemRarity::EIR_Common, { 13.f, 18.f } },
+		{ EWeaponType::EWT_SubmachineGun, EItemRarity::EIR_Uncommon, { 15.f, 20.f } },
+		{ EWeaponType::EWT_SubmachineGun, EItemRarity::EIR_Rare, { 18.f, 25.f } },
+		{ EWeaponType::EWT_SubmachineGun, EItemRarity::EIR_Legendary, { 35.f, 42.f } },
+
+		{ EWeaponType::EWT_AssaultRifle, EItemRarity::EIR_Damaged, { 15.f, 20.f } },
+		{ EWeaponType::EWT_AssaultRifle, EItemRarity::EIR_Common, { 18.f, 25.f } },
+		{ EWeaponType::EWT_AssaultRifle, EItemRarity::EIR_Uncommon, { 20.f, 30.f } },
+		{ EWeaponType::EWT_AssaultRifle, EItemRarity::EIR_Rare, { 24.f, 34.f } },
+		{ EWeaponType::EWT_AssaultRifle, EItemRarity::EIR_Legendary, { 40.f, 50.f } }
+	};
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FWeaponDamageMatrixTest, "UltimateShooter.WeaponDamage.DefaultMatrix",
+	EAutomationTestFlags::ApplicationContextMask | EAutomationTestFlags::ProductFilter)
+
+bool FWeaponDamageMatrixTest::RunTest(const FString& Parameters)
+{
+	using namespace WeaponDamageTest;
+
+	TestEqual(TEXT("Every combination is checked"), static_cast<int32>(UE_ARRAY_COUNT(ExpectedDamage)),
+		WeaponDamage::NumWeaponTypes * WeaponDamage::NumRarities);
+
+	for (const FExpectedDamage& Expected : ExpectedDamage)
+	{
+		const FWeaponDamageValues Values = WeaponDamage::GetDefaultDamage(Expected.Type, Expected.Rarity);
+		const FString Context = FString::Printf(TEXT("%s %s"), *UEnum::GetValueAsString(Expected.Type), *UEnum::GetValueAsString(Expected.Rarity));
+
+		TestEqual(*(Context + TEXT(" damage")), Values.Damage, Expected.Values.Damage);
+		TestEqual(*(Context + TEXT(" head shot damage")), Values.HeadShotDamage, Expected.Values.HeadShotDamage);
+	}
+
+	TestEqual(TEXT("MAX weapon type does no damage"), WeaponDamage::GetDefaultDamage(EWeaponType::EWT_DefaultMAX, EItemRarity::EIR_Rare).Damage, 0.f);
+	TestEqual(TEXT("MAX rarity does no damage"), WeaponDamage::GetDefaultDamage(EWeaponType::EWT_Pistol, EItemRarity::EIR_MAX).Damage, 0.f);
+
+	return true;
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FWeaponDamageFalloffTest, "UltimateShooter.WeaponDamage.Falloff",
+	EAutomationTestFlags::ApplicationContextMask | EAutomationTestFlags::ProductFilter)
+
+bool FWeaponDamageFalloffTest::RunTest(const FString& Parameters)
+{
+	//! Default model of a weapon without a DamageAsset keeps damage unchanged at any distance
+	const FWeaponDamageModel NoFalloff;
+	TestEqual(TEXT("No falloff"), NoFalloff.Evaluate(20.f, 100000.f), 20.f);
+	TestEqual(TEXT("No falloff with zone multiplier"), NoFalloff.Evaluate(20.f, 100000.f, 1.5f), 30.f);
+
+	FWeaponDamageModel Falloff;
+	Falloff.FalloffStartDistance = 1000.f;
+	Falloff.FalloffEndDistance = 3000.f;
+	Falloff.MinFalloffMultiplier = 0.5f;
+
+	TestEqual(TEXT("Full damage before the falloff"), Falloff.Evaluate(20.f, 500.f), 20.f);
+	TestEqual(TEXT("Full damage at the falloff start"), Falloff.Evaluate(20.f, 1000.f), 20.f);
+	TestEqual(TEXT("Halfway through the falloff"), Falloff.Evaluate(20.f, 2000.f), 15.f);
+	TestEqual(TEXT("Minimum at the falloff end"), Falloff.Evaluate(20.f, 3000.f), 10.f);
+	TestEqual(TEXT("Minimum beyond the falloff end"), Falloff.Evaluate(20.f, 10000.f), 10.f);
+	TestEqual(TEXT("Zone multiplier applies with falloff"), Falloff.Evaluate(20.f, 2000.f, 2.f), 30.f);
+
+	return true;
+}
+
+#endif
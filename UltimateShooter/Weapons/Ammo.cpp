@@ -9,6 +9,7 @@
 
 AAmmo::AAmmo() :
     AmmoType{EAmmoType::EAT_9mm},
+	bFalling{false},
 	ThrowAmmoTime{1.f}
 {
 	PrimaryActorTick.bCanEverTick = true;
@@ -143,4 +144,18 @@ void AAmmo::StopFalling()
 	SetItemState(EItemState::EIS_Pickup);
     bFalling = false;
     StartPulseTimer();
-}
\ No newline at end of file
+}
+
+void AAmmo::DeactivateForPool()
+{
+	bFalling = false;
+
+	Super::DeactivateForPool();
+}
+
+void AAmmo::ActivateFromPool(const FVector& Location, const FRotator& Rotation)
+{
+	Super::ActivateFromPool(Location, Rotation);
+
+	AmmoCollisionSphere->SetCollisionEnabled(ECollisionEnabled::QueryOnly);
+}
@@ -107,4 +107,14 @@ public:
 	 * Applies an impulse to the mesh and sets its state to Falling.
 	 */
 	void ThrowAmmo();
+
+	/** 
+	 * Clears the falling state before the ammo is parked by ULootPoolSubsystem.
+	 */
+	virtual void DeactivateForPool() override;
+
+	/** 
+	 * Re-enables the pickup sphere, which is disabled once the ammo is picked up.
+	 */
+	virtual void ActivateFromPool(const FVector& Location, const FRotator& Rotation) override;
 };
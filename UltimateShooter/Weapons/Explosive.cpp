@@ -5,6 +5,9 @@
 #include "Kismet/GameplayStatics.h"
 #include "Sound/SoundCue.h"
 #include "Particles/ParticleSystemComponent.h"
+#include "UltimateShooter/Subsystems/FXBudgetSubsystem.h"
+#include "UltimateShooter/Subsystems/SoundDispatchSubsystem.h"
+#include "UltimateShooter/Subsystems/DamagePipelineSubsystem.h"
 #include "Components/SphereComponent.h"
 #include "GameFramework/Character.h"
 
@@ -40,27 +43,27 @@ void AExplosive::BulletHit_Implementation(FHitResult HitResult, AActor* Shooter,
 {
 	if (ExplosiveParticles)
 	{
-		UGameplayStatics::SpawnEmitterAtLocation(GetWorld(), ExplosiveParticles, HitResult.Location, FRotator(0.f), true);
+		UFXBudgetSubsystem::SpawnEmitterAtLocation(this, ExplosiveParticles, FTransform(HitResult.Location));
 	}
 
 	if (ImpactSound)
 	{
-		UGameplayStatics::PlaySoundAtLocation(this, ImpactSound, HitResult.Location);
+		USoundDispatchSubsystem::PlaySoundAtLocation(this, ImpactSound, HitResult.Location, ESoundCategory::ESC_Explosion);
 	}
 
-	// TODO: Apply explosive damage
 	TArray<AActor*> OverlappingActors;
 	OverlapSphere->GetOverlappingActors(OverlappingActors, ACharacter::StaticClass());
 
 	for (AActor* Actor : OverlappingActors)
 	{
+		//! The shooter is damaged by the explosive itself, which is destroyed below, so that damage is not queued
 		if (Actor == Shooter)
 		{
-			Actor->TakeDamage(Damage, FDamageEvent::FDamageEvent(), ShooterController, this);
+			Actor->TakeDamage(Damage, FDamageEvent(), ShooterController, this);
 		}
 		else
 		{
-			UGameplayStatics::ApplyDamage(Actor, Damage, ShooterController, Shooter, UDamageType::StaticClass());
+			UDamagePipelineSubsystem::QueueDamage(this, Actor, Damage, ShooterController, Shooter);
 		}
 	}
 
@@ -10,6 +10,13 @@
 #include "Kismet/GameplayStatics.h"
 #include "Sound/SoundCue.h"
 #include "Curves/CurveVector.h"
+#include "UltimateShooter/UltimateShooter.h"
+#include "UltimateShooter/Subsystems/ItemDataSubsystem.h"
+#include "UltimateShooter/Subsystems/LootPoolSubsystem.h"
+
+DECLARE_DWORD_ACCUMULATOR_STAT(TEXT("Ticking Items"), STAT_TickingItems, STATGROUP_UltimateShooter);
+DECLARE_CYCLE_STAT(TEXT("SetRarityParameters"), STAT_SetRarityParameters, STATGROUP_UltimateShooter);
+DECLARE_DWORD_COUNTER_STAT(TEXT("Item Material Instances Created"), STAT_DynamicMaterialInstancesCreated, STATGROUP_UltimateShooter);
 
 
 // Sets default values
@@ -19,10 +26,13 @@ AItem::AItem() :
 	ItemInterpStartLocation{FVector(0.f)}, CameraTargetLocation{FVector(0.f)}, bInterping{false}, ZCurveTime{0.7f},
 	InterpInitialYawOffset{0.f}, InterpLocIndex{0}, MaterialIndex{0}, bCanChangeCustomDepth{true},
 	//? Dynamic Material Parameters
-	PulseCurveTime{5.f}, GlowAmount{150.f}, FersnelExponent{3.f}, FersnelReflectFraction{4.f}, SlotIndex{0}
+	PulseCurveTime{5.f}, GlowAmount{150.f}, FersnelExponent{3.f}, FersnelReflectFraction{4.f},
+	OverlappingCharacterCount{0}, bCountedAsTicking{false}, SlotIndex{0}
 {
  	// Set this actor to call Tick() every frame.  You can turn this off to improve performance if you don't need it.
 	PrimaryActorTick.bCanEverTick = true;
+	//! Tick is enabled by UpdateTickEnabled only while the item has something to update
+	PrimaryActorTick.bStartWithTickEnabled = false;
 
 	ItemMesh = CreateDefaultSubobject<USkeletalMeshComponent>(TEXT("ItemMesh"));
 	SetRootComponent(ItemMesh);
@@ -62,6 +72,45 @@ void AItem::BeginPlay()
 	InitializeCustomDepth();
 
 	StartPulseTimer();
+
+	UpdateTickEnabled();
+}
+
+void AItem::EndPlay(const EEndPlayReason::Type EndPlayReason)
+{
+	if (bCountedAsTicking)
+	{
+		DEC_DWORD_STAT(STAT_TickingItems);
+		bCountedAsTicking = false;
+	}
+
+	Super::EndPlay(EndPlayReason);
+}
+
+bool AItem::ShouldTick() const
+{
+	if (ItemState == EItemState::EIS_EquipInterping || ItemState == EItemState::EIS_Falling) return true;
+
+	//! Pickup pulse is only worth updating while someone is close enough to see it
+	return ItemState == EItemState::EIS_Pickup && OverlappingCharacterCount > 0;
+}
+
+void AItem::UpdateTickEnabled()
+{
+	const bool bShouldTick = ShouldTick();
+	if (bShouldTick == bCountedAsTicking) return;
+
+	SetActorTickEnabled(bShouldTick);
+	bCountedAsTicking = bShouldTick;
+
+	if (bShouldTick)
+	{
+		INC_DWORD_STAT(STAT_TickingItems);
+	}
+	else
+	{
+		DEC_DWORD_STAT(STAT_TickingItems);
+	}
 }
 
 void AItem::OnSphereOverlap(UPrimitiveComponent* OverlappedComponent, AActor* 
@@ -72,7 +121,9 @@ void AItem::OnSphereOverlap(UPrimitiveComponent* OverlappedComponent, AActor*
 		AShooterCharacter* ShooterCharacter = Cast<AShooterCharacter>(OtherActor);
 		if(ShooterCharacter != nullptr)
 		{
-			ShooterCharacter->IncrementOverlappedItemCount(1);
+			ShooterCharacter->AddFocusCandidate(this);
+			++OverlappingCharacterCount;
+			UpdateTickEnabled();
 		}
 	}
 }
@@ -85,8 +136,10 @@ void AItem::OnSphereEndOverlap(UPrimitiveComponent* OverlappedComponent, AActor*
 		AShooterCharacter* ShooterCharacter = Cast<AShooterCharacter>(OtherActor);
 		if(ShooterCharacter != nullptr)
 		{
-			ShooterCharacter->IncrementOverlappedItemCount(-1);
+			ShooterCharacter->RemoveFocusCandidate(this);
 			ShooterCharacter->UnHighlightInventorySlot();
+			OverlappingCharacterCount = FMath::Max(OverlappingCharacterCount - 1, 0);
+			UpdateTickEnabled();
 		}
 	}
 }
@@ -278,49 +331,27 @@ void AItem::UpdatePulse()
 
 void AItem::SetRarityParameters()
 {
-	//! Path to the Item Rarity Data Table
-	FString RarityTablePath(TEXT("DataTable'/Game/_Game/DataTable/ItemRarityDataTable.ItemRarityDataTable'"));
-	UDataTable* RarityTableObject = Cast<UDataTable>(StaticLoadObject(UDataTable::StaticClass(), nullptr, *RarityTablePath));
-	if (RarityTableObject)
+	SCOPE_CYCLE_COUNTER(STAT_SetRarityParameters);
+
+	//! Row comes preloaded from the item data subsystem
+	const FItemRarityTable* RarityRow = UItemDataSubsystem::FindRarityData(this, ItemRarity);
+	if (RarityRow)
 	{
-		FItemRarityTable* RarityRow = nullptr;
-		switch (ItemRarity)
-		{
-			case EItemRarity::EIR_Damaged:
-				RarityRow = RarityTableObject->FindRow<FItemRarityTable>(FName("Damaged"), TEXT(""));
-				break;
-			case EItemRarity::EIR_Common:
-				RarityRow = RarityTableObject->FindRow<FItemRarityTable>(FName("Common"), TEXT(""));
-				break;
-			case EItemRarity::EIR_Uncommon:
-				RarityRow = RarityTableObject->FindRow<FItemRarityTable>(FName("Uncommon"), TEXT(""));
-				break;
-			case EItemRarity::EIR_Rare:
-				RarityRow = RarityTableObject->FindRow<FItemRarityTable>(FName("Rare"), TEXT(""));
-				break;
-			case EItemRarity::EIR_Legendary:
-				RarityRow = RarityTableObject->FindRow<FItemRarityTable>(FName("Legendary"), TEXT(""));
-				break;
-		} 
-
-		if (RarityRow)
+		GlowColor = RarityRow->GlowColor;
+		LightColor = RarityRow->LightColor;
+		DarkColor = RarityRow->DarkColor;
+		NumberOfStars = RarityRow->NumberOfStars;
+		IconBackground = RarityRow->IconBackground;
+		if (GetItemMesh())
 		{
-			GlowColor = RarityRow->GlowColor;
-			LightColor = RarityRow->LightColor;
-			DarkColor = RarityRow->DarkColor;
-			NumberOfStars = RarityRow->NumberOfStars;
-			IconBackground = RarityRow->IconBackground;
-			if (GetItemMesh())
-			{
-				GetItemMesh()->SetCustomDepthStencilValue(RarityRow->CustomDepthStencil);
-			}
-			SetActiveStars();
+			GetItemMesh()->SetCustomDepthStencilValue(RarityRow->CustomDepthStencil);
 		}
+		SetActiveStars();
 	}
 
 	if (MaterialInstance)
 	{
-		DynamicMaterialInstance = UMaterialInstanceDynamic::Create(MaterialInstance, this);
+		UpdateDynamicMaterialInstance();
 		DynamicMaterialInstance->SetVectorParameterValue(TEXT("FersnelColor"), GlowColor);
 		ItemMesh->SetMaterial(MaterialIndex, DynamicMaterialInstance);
 
@@ -328,6 +359,52 @@ void AItem::SetRarityParameters()
 	}
 }
 
+void AItem::UpdateDynamicMaterialInstance()
+{
+	if (DynamicMaterialInstance && DynamicMaterialInstance->Parent == MaterialInstance) return;
+
+	DynamicMaterialInstance = UMaterialInstanceDynamic::Create(MaterialInstance, this);
+	INC_DWORD_STAT(STAT_DynamicMaterialInstancesCreated);
+}
+
+void AItem::DeactivateForPool()
+{
+	GetWorldTimerManager().ClearAllTimersForObject(this);
+	bInterping = false;
+	//! Character is kept, FinishInterping still uses it after the item is released from GetPickupItem
+
+	//! A parked item must not stay focused, or it could still be picked up while hidden
+	TArray<AActor*> OverlappingCharacters;
+	AreaSphere->GetOverlappingActors(OverlappingCharacters, AShooterCharacter::StaticClass());
+	for (AActor* OverlappingActor : OverlappingCharacters)
+	{
+		Cast<AShooterCharacter>(OverlappingActor)->ClearItemFocus(this);
+	}
+	if (Character)
+	{
+		Character->ClearItemFocus(this);
+	}
+	OverlappingCharacterCount = 0;
+
+	SetItemState(EItemState::EIS_Pickup);
+	DisableCustomDepth();
+	if (PickupWidget)
+	{
+		PickupWidget->SetVisibility(false);
+	}
+
+	SetActorEnableCollision(false);
+	SetActorHiddenInGame(true);
+}
+
+void AItem::ActivateFromPool(const FVector& Location, const FRotator& Rotation)
+{
+	Character = nullptr;
+	SetActorLocationAndRotation(Location, Rotation, false, nullptr, ETeleportType::ResetPhysics);
+	SetActorHiddenInGame(false);
+	SetActorEnableCollision(true);
+}
+
 // Called every frame
 void AItem::Tick(float DeltaTime)
 {
@@ -493,6 +570,16 @@ void AItem::SetItemState(EItemState NewState)
 {
 	ItemState = NewState;
 	SetItemProperties(NewState);
+	UpdateTickEnabled();
+
+	//! Picked up loot belongs to the character now, the live loot cap must not despawn it even after it is dropped
+	if (NewState != EItemState::EIS_Pickup && NewState != EItemState::EIS_Falling)
+	{
+		if (ULootPoolSubsystem* LootPool = ULootPoolSubsystem::Get(this))
+		{
+			LootPool->ForgetItem(this);
+		}
+	}
 }
 
 void AItem::StartItemCurve(AShooterCharacter* newCharacter, bool bForcePlaySound)
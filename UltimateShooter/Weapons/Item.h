@@ -107,6 +107,26 @@ protected:
 	void OnSphereEndOverlap(UPrimitiveComponent* OverlappedComponent, AActor* OtherActor,
 	UPrimitiveComponent* OtherComp, int32 OtherBodyIndex);
 
+	/**
+	 * @brief Called when the item is destroyed or removed from the level, keeps the ticking items stat balanced.
+	 */
+	virtual void EndPlay(const EEndPlayReason::Type EndPlayReason) override;
+
+	/**
+	 * @brief Checks if the item has anything to update in Tick.
+	 * 
+	 * Items only need to tick while they are interping to the character, while they are falling, or while a character
+	 * is inside AreaSphere and the pickup pulse is driven from the PulseCurve.
+	 * 
+	 * @return true If Tick should be enabled.
+	 */
+	virtual bool ShouldTick() const;
+
+	/**
+	 * @brief Enables or disables Tick based on ShouldTick. Called whenever something ShouldTick depends on changes.
+	 */
+	void UpdateTickEnabled();
+
 	//! Sets the ActiveStars array of bools based on rarirty
 	/**
 	 * @brief Sets the ActiveStars array based on the current item rarity.
@@ -186,6 +206,12 @@ protected:
 	 * @brief Loads data from Item Rarity Data Table and updates visuals accordingly.
 	 */
 	void SetRarityParameters();
+
+	/**
+	 * @brief Creates DynamicMaterialInstance from MaterialInstance, or keeps the current one if MaterialInstance is
+	 * already its parent, so reused items do not allocate a new instance every time they are set up.
+	 */
+	void UpdateDynamicMaterialInstance();
 	
 public:	
 	// Called every frame
@@ -310,6 +336,12 @@ private:
 
 	UPROPERTY(VisibleAnywhere, Category = "Item Properties", meta = (AllowPrivateAccess = "true"))
 	float FersnelReflectFraction;
+
+	//! Number of characters currently inside AreaSphere
+	int32 OverlappingCharacterCount;
+
+	//! True while this item is counted in the ticking items stat
+	bool bCountedAsTicking;
 	
 	//! Icon for this item in the inventory
 	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "Inventory", meta = (AllowPrivateAccess = "true"))
@@ -422,5 +454,21 @@ public:
 	 */
 	void DisableGlowMaterial();
 
+	/**
+	 * @brief Parks the item hidden and without collision so ULootPoolSubsystem can reuse it.
+	 * 
+	 * Clears timers, removes the item from the focus of every character in range and puts the item back into the
+	 * Pickup state.
+	 */
+	virtual void DeactivateForPool();
+
+	/**
+	 * @brief Brings a parked item back into the world.
+	 * 
+	 * @param Location Where the item is spawned.
+	 * @param Rotation Rotation of the spawned item.
+	 */
+	virtual void ActivateFromPool(const FVector& Location, const FRotator& Rotation);
+
 };
 
@@ -2,11 +2,22 @@
 
 
 #include "Weapon.h"
+#include "Sound/SoundCue.h"
+#include "Particles/ParticleSystem.h"
+#include "Engine/SkeletalMesh.h"
+#include "Engine/Texture2D.h"
+#include "Materials/MaterialInstance.h"
+#include "UltimateShooter/UltimateShooter.h"
+#include "UltimateShooter/Subsystems/ItemDataSubsystem.h"
+#include "UltimateShooter/Weapons/WeaponDamageAsset.h"
+
+DECLARE_CYCLE_STAT(TEXT("SetWeaponParameters"), STAT_SetWeaponParameters, STATGROUP_UltimateShooter);
+DECLARE_CYCLE_STAT(TEXT("SetUpSpawnedWeapon"), STAT_SetUpSpawnedWeapon, STATGROUP_UltimateShooter);
 
 AWeapon::AWeapon() : 
     ThrowWeaponTime{1.f},bFalling{false}, Ammo{30}, MagazineCapacity{30}, WeaponType{EWeaponType::EWT_SubmachineGun},
-    AmmoType{EAmmoType::EAT_9mm}, ReloadMontageSection{FName(TEXT("Reload SMG"))}, ClipBoneName{TEXT("smg_clip")}, BoneToHide{FName("")},
-    SlideDisplacement{0.f}, SlideDisplacementTime{0.2f}, MaxSlideDisplacement{8.f}, bAutomatic{true}
+    AmmoType{EAmmoType::EAT_9mm}, ReloadMontageSection{FName(TEXT("Reload SMG"))}, ClipBoneName{TEXT("smg_clip")}, BarrelSocketName{TEXT("BarrelSocket")}, BoneToHide{FName("")},
+    SlideDisplacement{0.f}, SlideDisplacementTime{0.2f}, bMovingSlide{false}, MaxSlideDisplacement{8.f}, bAutomatic{true}
 {
     PrimaryActorTick.bCanEverTick = true;
 
@@ -34,6 +45,12 @@ void AWeapon::BeginPlay()
 void AWeapon::FinishMovingSlide()
 {
     bMovingSlide = false;
+    UpdateTickEnabled();
+}
+
+bool AWeapon::ShouldTick() const
+{
+    return Super::ShouldTick() || bMovingSlide;
 }
 
 void AWeapon::UpdateSlideDisplacement()
@@ -48,149 +65,65 @@ void AWeapon::UpdateSlideDisplacement()
 
 void AWeapon::SetWeaponParameters()
 {
-    const FString WeaponTablePath{ TEXT("DataTable'/Game/_Game/DataTable/WeaponDataTable.WeaponDataTable'") };
-    UDataTable* WeaponTableObject = Cast<UDataTable>(StaticLoadObject(UDataTable::StaticClass(), nullptr, *WeaponTablePath));
+    SCOPE_CYCLE_COUNTER(STAT_SetWeaponParameters);
 
-    if (WeaponTableObject)
-    {
-        FWeaponDataTable* WeaponRow = nullptr;
-        switch (WeaponType)
-        {
-            case EWeaponType::EWT_SubmachineGun:
-                WeaponRow = WeaponTableObject->FindRow<FWeaponDataTable>(FName("SubmachineGun"), TEXT(""));
-                break;
-            case EWeaponType::EWT_AssaultRifle:
-                WeaponRow = WeaponTableObject->FindRow<FWeaponDataTable>(FName("AssaultRifle"), TEXT(""));
-                break;
-            case EWeaponType::EWT_Pistol:
-                WeaponRow = WeaponTableObject->FindRow<FWeaponDataTable>(FName("Pistol"), TEXT(""));
-                break;
-        }
+    //! Row comes preloaded from the item data subsystem
+    const FWeaponDataTable* WeaponRow = UItemDataSubsystem::FindWeaponData(this, WeaponType);
 
-        if (WeaponRow)
-        {
-            AmmoType = WeaponRow->AmmoType;
-            Ammo = WeaponRow->WeaponAmmo;
-            MagazineCapacity = WeaponRow->MagazineCapacity;
-            SetPickupSound(WeaponRow->PickupSound);
-            SetEquipSound(WeaponRow->EquipSound);
-            GetItemMesh()->SetSkeletalMesh(WeaponRow->ItemMesh);
-            SetItemName(WeaponRow->ItemName);
-            SetIconItem(WeaponRow->InventoryIcon);
-            SetAmmoItem(WeaponRow->AmmoIcon);
-
-            SetMaterialInstance(WeaponRow->MaterialInstance);
-            PreviousMaterialIndex = GetMaterialIndex();
-            GetItemMesh()->SetMaterial(PreviousMaterialIndex, nullptr);
-            SetMaterialIndex(WeaponRow->MaterialIndex);
-            SetClipBoneName(WeaponRow->ClipBoneName);
-            SetReloadMontageSection(WeaponRow->ReloadMontageSection);
-            GetItemMesh()->SetAnimInstanceClass(WeaponRow->AnimBP);
-            CrosshairsMiddle = WeaponRow->CrosshairsMiddle;
-            CrosshairsTop = WeaponRow->CrosshairsTop;
-            CrosshairsBottom = WeaponRow->CrosshairsBottom;
-            CrosshairsLeft = WeaponRow->CrosshairsLeft;
-            CrosshairsRight = WeaponRow->CrosshairsRight;
-            AutoFireRate = WeaponRow->AutoFireRate;
-            MuzzleFlash = WeaponRow->MuzzleFlash;
-            FireSound = WeaponRow->FireSound;
-            BoneToHide = WeaponRow->BoneToHide;
-            bAutomatic = WeaponRow->bAutomatic;
-            Damage = WeaponRow->Damage;
-            HeadShotDamage = WeaponRow->HeadShotDamage;
-        }
+    if (WeaponRow)
+    {
+        //! Assets not streamed in yet are loaded right here
+        AmmoType = WeaponRow->AmmoType;
+        Ammo = WeaponRow->WeaponAmmo;
+        MagazineCapacity = WeaponRow->MagazineCapacity;
+        SetPickupSound(UItemDataSubsystem::ResolveWeaponAsset(WeaponRow->PickupSound));
+        SetEquipSound(UItemDataSubsystem::ResolveWeaponAsset(WeaponRow->EquipSound));
+        GetItemMesh()->SetSkeletalMesh(UItemDataSubsystem::ResolveWeaponAsset(WeaponRow->ItemMesh));
+        SetItemName(WeaponRow->ItemName);
+        SetIconItem(UItemDataSubsystem::ResolveWeaponAsset(WeaponRow->InventoryIcon));
+        SetAmmoItem(UItemDataSubsystem::ResolveWeaponAsset(WeaponRow->AmmoIcon));
+
+        SetMaterialInstance(UItemDataSubsystem::ResolveWeaponAsset(WeaponRow->MaterialInstance));
+        PreviousMaterialIndex = GetMaterialIndex();
+        GetItemMesh()->SetMaterial(PreviousMaterialIndex, nullptr);
+        SetMaterialIndex(WeaponRow->MaterialIndex);
+        SetClipBoneName(WeaponRow->ClipBoneName);
+        SetReloadMontageSection(WeaponRow->ReloadMontageSection);
+        GetItemMesh()->SetAnimInstanceClass(UItemDataSubsystem::ResolveWeaponClass(WeaponRow->AnimBP));
+        CrosshairsMiddle = UItemDataSubsystem::ResolveWeaponAsset(WeaponRow->CrosshairsMiddle);
+        CrosshairsTop = UItemDataSubsystem::ResolveWeaponAsset(WeaponRow->CrosshairsTop);
+        CrosshairsBottom = UItemDataSubsystem::ResolveWeaponAsset(WeaponRow->CrosshairsBottom);
+        CrosshairsLeft = UItemDataSubsystem::ResolveWeaponAsset(WeaponRow->CrosshairsLeft);
+        CrosshairsRight = UItemDataSubsystem::ResolveWeaponAsset(WeaponRow->CrosshairsRight);
+        AutoFireRate = WeaponRow->AutoFireRate;
+        MuzzleFlash = UItemDataSubsystem::ResolveWeaponAsset(WeaponRow->MuzzleFlash);
+        FireSound = UItemDataSubsystem::ResolveWeaponAsset(WeaponRow->FireSound);
+        BoneToHide = WeaponRow->BoneToHide;
+        bAutomatic = WeaponRow->bAutomatic;
+        Damage = WeaponRow->Damage;
+        HeadShotDamage = WeaponRow->HeadShotDamage;
+    }
 
-        if (GetMaterialInstance())
-        {
-            SetDynamicMaterialInstance(UMaterialInstanceDynamic::Create(GetMaterialInstance(), this));
-            GetDynamicMaterialInstance()->SetVectorParameterValue(TEXT("FersnelColor"), GetGlowColor());
-            GetItemMesh()->SetMaterial(GetMaterialIndex(), GetDynamicMaterialInstance());
+    if (GetMaterialInstance())
+    {
+        UpdateDynamicMaterialInstance();
+        GetDynamicMaterialInstance()->SetVectorParameterValue(TEXT("FersnelColor"), GetGlowColor());
+        GetItemMesh()->SetMaterial(GetMaterialIndex(), GetDynamicMaterialInstance());
 
-            EnableGlowMaterial();
-        }
+        EnableGlowMaterial();
     }
 }
 
 void AWeapon::SetWeaponDamage()
 {
-    if (WeaponType == EWeaponType::EWT_Pistol)
-    {
-        switch (GetItemRarity())
-        {
-            case EItemRarity::EIR_Damaged:
-                Damage = 10.f;
-                HeadShotDamage = 15.f;
-            break;
-            case EItemRarity::EIR_Common:
-                Damage = 12.f;
-                HeadShotDamage = 17.f;
-            break;
-            case EItemRarity::EIR_Uncommon:
-                Damage = 14.f;
-                HeadShotDamage = 20.f;
-            break;
-            case EItemRarity::EIR_Rare:
-                Damage = 15.f;
-                HeadShotDamage = 25.f;
-            break;
-            case EItemRarity::EIR_Legendary:
-                Damage = 50.f;
-                HeadShotDamage = 100.f;
-            break;
-        }
-    }
-    else if (WeaponType == EWeaponType::EWT_SubmachineGun)
-    {
-        switch (GetItemRarity())
-        {
-            case EItemRarity::EIR_Damaged:
-                Damage = 11.f;
-                HeadShotDamage = 16.f;
-            break;
-            case EItemRarity::EIR_Common:
-                Damage = 13.f;
-                HeadShotDamage = 18.f;
-            break;
-            case EItemRarity::EIR_Uncommon:
-                Damage = 15.f;
-                HeadShotDamage = 20.f;
-            break;
-            case EItemRarity::EIR_Rare:
-                Damage = 18.f;
-                HeadShotDamage = 25.f;
-            break;
-            case EItemRarity::EIR_Legendary:
-                Damage = 35.f;
-                HeadShotDamage = 42.f;
-            break;
-        }
-    }
-    else if (WeaponType == EWeaponType::EWT_AssaultRifle)
-    {
-        switch (GetItemRarity())
-        {
-            case EItemRarity::EIR_Damaged:
-                Damage = 15.f;
-                HeadShotDamage = 20.f;
-            break;
-            case EItemRarity::EIR_Common:
-                Damage = 18.f;
-                HeadShotDamage = 25.f;
-            break;
-            case EItemRarity::EIR_Uncommon:
-                Damage = 20.f;
-                HeadShotDamage = 30.f;
-            break;
-            case EItemRarity::EIR_Rare:
-                Damage = 24.f;
-                HeadShotDamage = 34.f;
-            break;
-            case EItemRarity::EIR_Legendary:
-                Damage = 40.f;
-                HeadShotDamage = 50.f;
-            break;
-        }
-    }
+    if (WeaponType == EWeaponType::EWT_DefaultMAX || GetItemRarity() == EItemRarity::EIR_MAX) return;
+
+    const FWeaponDamageValues DamageValues{ DamageAsset ? 
+        DamageAsset->GetDamage(WeaponType, GetItemRarity()) : WeaponDamage::GetDefaultDamage(WeaponType, GetItemRarity()) };
+
+    Damage = DamageValues.Damage;
+    HeadShotDamage = DamageValues.HeadShotDamage;
+    DamageModel = DamageAsset ? DamageAsset->GetDamageModel() : FWeaponDamageModel();
 }
 
 void AWeapon::HideAccessories()
@@ -333,6 +266,20 @@ void AWeapon::StopFalling()
     StartPulseTimer();
 }
 
+void AWeapon::DeactivateForPool()
+{
+    bFalling = false;
+    bMovingSlide = false;
+
+    //! A dropped weapon goes back with the ammo it had, parked weapons start with a full magazine again
+    if (const FWeaponDataTable* WeaponRow = UItemDataSubsystem::FindWeaponData(this, WeaponType))
+    {
+        Ammo = WeaponRow->WeaponAmmo;
+    }
+
+    Super::DeactivateForPool();
+}
+
 void AWeapon::OnConstruction(const FTransform& Transform)
 {
     Super::OnConstruction(Transform);
@@ -346,6 +293,7 @@ void AWeapon::OnConstruction(const FTransform& Transform)
 void AWeapon::StartSlideTimer()
 {
     bMovingSlide = true;
+    UpdateTickEnabled();
     GetWorldTimerManager().SetTimer(SlideTimer, this, &AWeapon::FinishMovingSlide, SlideDisplacementTime);
 }
 
@@ -362,6 +310,8 @@ bool AWeapon::ClipIsFull()
 
 void AWeapon::SetUpSpawnedWeapon()
 {
+    SCOPE_CYCLE_COUNTER(STAT_SetUpSpawnedWeapon);
+
     int WeaponTypeNum = FMath::RandRange(1,3);
     EWeaponType Type = EWeaponType::EWT_DefaultMAX;
     EItemRarity Rarity = EItemRarity::EIR_MAX;
@@ -413,4 +363,14 @@ void AWeapon::SetUpSpawnedWeapon()
 
         SetUpAccessories(true);
     }
-}
\ No newline at end of file
+}
+
+const USkeletalMeshSocket* AWeapon::GetBarrelSocket()
+{
+    return BarrelSocket.Get(this, GetItemMesh(), BarrelSocketName);
+}
+
+int32 AWeapon::GetClipBoneIndex()
+{
+    return ClipBone.Get(this, GetItemMesh(), ClipBoneName);
+}
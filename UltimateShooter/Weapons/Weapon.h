@@ -7,8 +7,19 @@
 #include "UltimateShooter/Enums/AmmoType.h"
 #include "Engine/DataTable.h"
 #include "UltimateShooter/Enums/WeaponType.h"
+#include "UltimateShooter/Weapons/WeaponDamage.h"
+#include "UltimateShooter/Subsystems/SocketCacheSubsystem.h"
 #include "Weapon.generated.h"
 
+/**
+ * @brief Row of the Weapon Data Table.
+ * 
+ * Assets are soft references so loading the table does not load every weapon's assets. They are streamed in per weapon
+ * type by UItemDataSubsystem before the weapon is needed.
+ *
+ * A table saved while these were hard references still loads its assets as hard imports. Resave the Weapon Data Table
+ * asset in the editor (or run the ResavePackages commandlet on it) once, otherwise loading it still loads every asset.
+ */
 USTRUCT(BlueprintType)
 struct FWeaponDataTable : public FTableRowBase
 {
@@ -24,25 +35,25 @@ struct FWeaponDataTable : public FTableRowBase
 	int32 MagazineCapacity;
 	
 	UPROPERTY(EditAnywhere, BlueprintReadWrite)
-	class USoundCue* PickupSound;
+	TSoftObjectPtr<class USoundCue> PickupSound;
 	
 	UPROPERTY(EditAnywhere, BlueprintReadWrite)
-	USoundCue* EquipSound;
+	TSoftObjectPtr<USoundCue> EquipSound;
 	
 	UPROPERTY(EditAnywhere, BlueprintReadWrite)
-	USkeletalMesh* ItemMesh;
+	TSoftObjectPtr<USkeletalMesh> ItemMesh;
 	
 	UPROPERTY(EditAnywhere, BlueprintReadWrite)
 	FString ItemName;
 	
 	UPROPERTY(EditAnywhere, BlueprintReadWrite)
-	UTexture2D* InventoryIcon;
+	TSoftObjectPtr<UTexture2D> InventoryIcon;
 	
 	UPROPERTY(EditAnywhere, BlueprintReadWrite)
-	UTexture2D* AmmoIcon;
+	TSoftObjectPtr<UTexture2D> AmmoIcon;
 	
 	UPROPERTY(EditAnywhere, BlueprintReadWrite)
-	UMaterialInstance* MaterialInstance;
+	TSoftObjectPtr<UMaterialInstance> MaterialInstance;
 	
 	UPROPERTY(EditAnywhere, BlueprintReadWrite)
 	int32 MaterialIndex;
@@ -54,31 +65,31 @@ struct FWeaponDataTable : public FTableRowBase
 	FName ReloadMontageSection;
 
 	UPROPERTY(EditAnywhere, BlueprintReadWrite)
-	TSubclassOf<UAnimInstance> AnimBP;
+	TSoftClassPtr<UAnimInstance> AnimBP;
 	
 	UPROPERTY(EditAnywhere, BlueprintReadWrite)
-	UTexture2D* CrosshairsMiddle;
+	TSoftObjectPtr<UTexture2D> CrosshairsMiddle;
 	
 	UPROPERTY(EditAnywhere, BlueprintReadWrite)
-	UTexture2D* CrosshairsTop;
+	TSoftObjectPtr<UTexture2D> CrosshairsTop;
 	
 	UPROPERTY(EditAnywhere, BlueprintReadWrite)
-	UTexture2D* CrosshairsBottom;
+	TSoftObjectPtr<UTexture2D> CrosshairsBottom;
 	
 	UPROPERTY(EditAnywhere, BlueprintReadWrite)
-	UTexture2D* CrosshairsLeft;
+	TSoftObjectPtr<UTexture2D> CrosshairsLeft;
 	
 	UPROPERTY(EditAnywhere, BlueprintReadWrite)
-	UTexture2D* CrosshairsRight;
+	TSoftObjectPtr<UTexture2D> CrosshairsRight;
 	
 	UPROPERTY(EditAnywhere, BlueprintReadWrite)
 	float AutoFireRate;
 	
 	UPROPERTY(EditAnywhere, BlueprintReadWrite)
-	class UParticleSystem* MuzzleFlash;
+	TSoftObjectPtr<class UParticleSystem> MuzzleFlash;
 	
 	UPROPERTY(EditAnywhere, BlueprintReadWrite)
-	USoundCue* FireSound;
+	TSoftObjectPtr<USoundCue> FireSound;
 	
 	UPROPERTY(EditAnywhere, BlueprintReadWrite)
 	FName BoneToHide;
@@ -165,6 +176,15 @@ protected:
 	 */
 	void UpdateSlideDisplacement();
 
+	/**
+	 * @brief Checks if the weapon has anything to update in Tick.
+	 * 
+	 * On top of the AItem conditions the weapon also ticks while the slide is moving after a shot.
+	 * 
+	 * @return true If Tick should be enabled.
+	 */
+	virtual bool ShouldTick() const override;
+
 	/**
 	 * @brief Sets the weapon's parameters based on data from a DataTable.
 	 * 
@@ -178,8 +198,9 @@ protected:
 	/**
 	 * @brief Sets the damage values (base and headshot) based on the weapon's type and rarity.
 	 * 
-	 * Uses nested 'switch' and 'if-else' structures to define specific damage values
-	 * for each combination of weapon type (Pistol, SMG, Assault Rifle) and item rarity (from Damaged to Legendary).
+	 * Reads the damage from DamageAsset if one is set, otherwise from WeaponDamage::DefaultMatrix, which holds
+	 * the damage for each combination of weapon type (Pistol, SMG, Assault Rifle) and item rarity (from Damaged to Legendary).
+	 * Also sets the DamageModel used for damage falloff.
 	 */
 	void SetWeaponDamage();
 
@@ -227,6 +248,16 @@ private:
 	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "WeaponProperties", meta = (AllowPrivateAccess = "true"))
 	FName ClipBoneName; 
 
+	//! Socket at the end of the barrel, bullets and the muzzle flash start there
+	UPROPERTY(EditDefaultsOnly, BlueprintReadOnly, Category = "WeaponProperties", meta = (AllowPrivateAccess = "true"))
+	FName BarrelSocketName;
+
+	//! BarrelSocketName resolved on the current weapon mesh
+	FCachedSocket BarrelSocket;
+
+	//! ClipBoneName resolved on the current weapon mesh
+	FCachedBone ClipBone;
+
 	int32 PreviousMaterialIndex;
 
 	UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Category = "DataTable", meta = (AllowPrivateAccess = "true"))
@@ -286,6 +317,13 @@ private:
 	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "Weapon Properties", meta = (AllowPrivateAccess = "true"))
 	bool bAutomatic;
 	
+	//! Optional damage tuning, overrides the default damage matrix and adds damage falloff
+	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "Weapon Properties", meta = (AllowPrivateAccess = "true"))
+	class UWeaponDamageAsset* DamageAsset;
+
+	//! Damage falloff evaluated for every bullet that hits
+	FWeaponDamageModel DamageModel;
+
 	//! Amount of damage caused by a bullet
 	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "Weapon Properties", meta = (AllowPrivateAccess = "true"))
 	float Damage;
@@ -311,6 +349,7 @@ public:
 	FORCEINLINE FName GetReloadMontageSection() const { return ReloadMontageSection; }
 	FORCEINLINE void SetReloadMontageSection(FName Section) { ReloadMontageSection = Section; } 
 	FORCEINLINE FName GetClipBoneName() const { return ClipBoneName; }
+	FORCEINLINE FName GetBarrelSocketName() const { return BarrelSocketName; }
 	FORCEINLINE void SetClipBoneName(FName Name) { ClipBoneName = Name; }
 	FORCEINLINE float GetAutoFireRate() const { return AutoFireRate; }
 	FORCEINLINE UParticleSystem* GetMuzzleFlash() const { return MuzzleFlash; }
@@ -318,6 +357,7 @@ public:
 	FORCEINLINE bool GetAutomatic() const { return bAutomatic; }
 	FORCEINLINE float GetDamage() const { return Damage; }
 	FORCEINLINE float GetHeadShotDamage() const { return HeadShotDamage; }
+	FORCEINLINE const FWeaponDamageModel& GetDamageModel() const { return DamageModel; }
 	FORCEINLINE void SetMovingClip(bool Move) { bMovingClip = Move; }
 
 	//! Adds an impulse to the weapon
@@ -330,6 +370,11 @@ public:
 	 * It also enables the glow material.
 	 */
 	void ThrowWeapon();
+
+	/**
+	 * @brief Clears the falling and slide state and refills the ammo before the weapon is parked by ULootPoolSubsystem.
+	 */
+	virtual void DeactivateForPool() override;
 	
 	//! Called from character class when firing weapon
 	/**
@@ -388,4 +433,18 @@ public:
 	 * of the ARSuppressor and ARRedDot components to visible.
 	 */
 	void ShowAccessories();
+
+	/**
+	 * @brief Gets the barrel socket of the weapon mesh, resolved again only when the mesh changes
+	 * 
+	 * @return const USkeletalMeshSocket* Socket, or nullptr if the mesh has no barrel socket
+	 */
+	const USkeletalMeshSocket* GetBarrelSocket();
+
+	/**
+	 * @brief Gets the index of the clip bone on the weapon mesh, resolved again only when the mesh or ClipBoneName changes
+	 * 
+	 * @return int32 Bone index, or INDEX_NONE if the mesh has no clip bone
+	 */
+	int32 GetClipBoneIndex();
 };
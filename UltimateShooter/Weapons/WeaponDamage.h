@@ -0,0 +1,101 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "UltimateShooter/Weapons/Item.h"
+#include "UltimateShooter/Enums/WeaponType.h"
+
+/**
+ * @brief Body and head shot damage of a weapon.
+ */
+struct FWeaponDamageValues
+{
+	float Damage;
+	float HeadShotDamage;
+};
+
+/**
+ * @brief Damage falloff over distance, evaluated for every bullet that hits.
+ * 
+ * Full damage up to FalloffStartDistance, then linearly down to MinFalloffMultiplier of it at FalloffEndDistance.
+ * If FalloffEndDistance is not greater than FalloffStartDistance there is no falloff.
+ */
+struct FWeaponDamageModel
+{
+	float FalloffStartDistance{ 0.f };
+	float FalloffEndDistance{ 0.f };
+	float MinFalloffMultiplier{ 1.f };
+
+	/**
+	 * @brief Gets the damage a bullet does
+	 * 
+	 * @param BaseDamage Body or head shot damage of the weapon
+	 * @param Distance Distance from the muzzle to the hit location
+	 * @param ZoneMultiplier Multiplier of the hit zone or bone that was hit
+	 * @return float Damage to apply
+	 */
+	FORCEINLINE float Evaluate(float BaseDamage, float Distance, float ZoneMultiplier = 1.f) const
+	{
+		if (FalloffEndDistance <= FalloffStartDistance || Distance <= FalloffStartDistance)
+		{
+			return BaseDamage * ZoneMultiplier;
+		}
+
+		const float Alpha = FMath::Min((Distance - FalloffStartDistance) / (FalloffEndDistance - FalloffStartDistance), 1.f);
+		return BaseDamage * ZoneMultiplier * FMath::Lerp(1.f, MinFalloffMultiplier, Alpha);
+	}
+};
+
+namespace WeaponDamage
+{
+	constexpr int32 NumWeaponTypes{ static_cast<int32>(EWeaponType::EWT_DefaultMAX) };
+	constexpr int32 NumRarities{ static_cast<int32>(EItemRarity::EIR_MAX) };
+
+	//! Default damage indexed by [EWeaponType][EItemRarity], columns are Damaged, Common, Uncommon, Rare, Legendary
+	constexpr FWeaponDamageValues DefaultMatrix[NumWeaponTypes][NumRarities]
+	{
+		//! EWT_SubmachineGun
+		{ { 11.f, 16.f }, { 13.f, 18.f }, { 15.f, 20.f }, { 18.f, 25.f }, { 35.f, 42.f } },
+		//! EWT_AssaultRifle
+		{ { 15.f, 20.f }, { 18.f, 25.f }, { 20.f, 30.f }, { 24.f, 34.f }, { 40.f, 50.f } },
+		//! EWT_Pistol
+		{ { 10.f, 15.f }, { 12.f, 17.f }, { 14.f, 20.f }, { 15.f, 25.f }, { 50.f, 100.f } }
+	};
+
+	/**
+	 * @brief Gets the default damage of the weapon type and rarity
+	 * 
+	 * @return FWeaponDamageValues Damage from DefaultMatrix, zero if Type or Rarity is a MAX value
+	 */
+	constexpr FWeaponDamageValues GetDefaultDamage(EWeaponType Type, EItemRarity Rarity)
+	{
+		const int32 TypeIndex{ static_cast<int32>(Type) };
+		const int32 RarityIndex{ static_cast<int32>(Rarity) };
+		return (TypeIndex < NumWeaponTypes && RarityIndex < NumRarities) ? DefaultMatrix[TypeIndex][RarityIndex] : FWeaponDamageValues{ 0.f, 0.f };
+	}
+
+	//! Checks that the matrix matches the damage values that used to be hardcoded in AWeapon::SetWeaponDamage
+	constexpr bool Matches(EWeaponType Type, EItemRarity Rarity, float Damage, float HeadShotDamage)
+	{
+		return GetDefaultDamage(Type, Rarity).Damage == Damage && GetDefaultDamage(Type, Rarity).HeadShotDamage == HeadShotDamage;
+	}
+
+	static_assert(Matches(EWeaponType::EWT_Pistol, EItemRarity::EIR_Damaged, 10.f, 15.f), "Pistol Damaged damage changed");
+	static_assert(Matches(EWeaponType::EWT_Pistol, EItemRarity::EIR_Common, 12.f, 17.f), "Pistol Common damage changed");
+	static_assert(Matches(EWeaponType::EWT_Pistol, EItemRarity::EIR_Uncommon, 14.f, 20.f), "Pistol Uncommon damage changed");
+	static_assert(Matches(EWeaponType::EWT_Pistol, EItemRarity::EIR_Rare, 15.f, 25.f), "Pistol Rare damage changed");
+	static_assert(Matches(EWeaponType::EWT_Pistol, EItemRarity::EIR_Legendary, 50.f, 100.f), "Pistol Legendary damage changed");
+
+	static_assert(Matches(EWeaponType::EWT_SubmachineGun, EItemRarity::EIR_Damaged, 11.f, 16.f), "SMG Damaged damage changed");
+	static_assert(Matches(EWeaponType::EWT_SubmachineGun, EItemRarity::EIR_Common, 13.f, 18.f), "SMG Common damage changed");
+	static_assert(Matches(EWeaponType::EWT_SubmachineGun, EItemRarity::EIR_Uncommon, 15.f, 20.f), "SMG Uncommon damage changed");
+	static_assert(Matches(EWeaponType::EWT_SubmachineGun, EItemRarity::EIR_Rare, 18.f, 25.f), "SMG Rare damage changed");
+	static_assert(Matches(EWeaponType::EWT_SubmachineGun, EItemRarity::EIR_Legendary, 35.f, 42.f), "SMG Legendary damage changed");
+
+	static_assert(Matches(EWeaponType::EWT_AssaultRifle, EItemRarity::EIR_Damaged, 15.f, 20.f), "AR Damaged damage changed");
+	static_assert(Matches(EWeaponType::EWT_AssaultRifle, EItemRarity::EIR_Common, 18.f, 25.f), "AR Common damage changed");
+	static_assert(Matches(EWeaponType::EWT_AssaultRifle, EItemRarity::EIR_Uncommon, 20.f, 30.f), "AR Uncommon damage changed");
+	static_assert(Matches(EWeaponType::EWT_AssaultRifle, EItemRarity::EIR_Rare, 24.f, 34.f), "AR Rare damage changed");
+	static_assert(Matches(EWeaponType::EWT_AssaultRifle, EItemRarity::EIR_Legendary, 40.f, 50.f), "AR Legendary damage changed");
+}
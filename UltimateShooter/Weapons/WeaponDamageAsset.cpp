@@ -0,0 +1,32 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+
+#include "WeaponDamageAsset.h"
+
+UWeaponDamageAsset::UWeaponDamageAsset() :
+	FalloffStartDistance{0.f}, FalloffEndDistance{0.f}, MinFalloffMultiplier{1.f}
+{
+
+}
+
+FWeaponDamageValues UWeaponDamageAsset::GetDamage(EWeaponType Type, EItemRarity Rarity) const
+{
+	for (const FWeaponDamageOverride& Override : DamageOverrides)
+	{
+		if (Override.WeaponType == Type && Override.ItemRarity == Rarity)
+		{
+			return FWeaponDamageValues{ Override.Damage, Override.HeadShotDamage };
+		}
+	}
+
+	return WeaponDamage::GetDefaultDamage(Type, Rarity);
+}
+
+FWeaponDamageModel UWeaponDamageAsset::GetDamageModel() const
+{
+	FWeaponDamageModel DamageModel;
+	DamageModel.FalloffStartDistance = FalloffStartDistance;
+	DamageModel.FalloffEndDistance = FalloffEndDistance;
+	DamageModel.MinFalloffMultiplier = MinFalloffMultiplier;
+	return DamageModel;
+}
@@ -0,0 +1,77 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Engine/DataAsset.h"
+#include "UltimateShooter/Weapons/WeaponDamage.h"
+#include "WeaponDamageAsset.generated.h"
+
+USTRUCT(BlueprintType)
+struct FWeaponDamageOverride
+{
+	GENERATED_BODY()
+
+	UPROPERTY(EditAnywhere, BlueprintReadWrite)
+	EWeaponType WeaponType;
+
+	UPROPERTY(EditAnywhere, BlueprintReadWrite)
+	EItemRarity ItemRarity;
+
+	UPROPERTY(EditAnywhere, BlueprintReadWrite)
+	float Damage;
+
+	UPROPERTY(EditAnywhere, BlueprintReadWrite)
+	float HeadShotDamage;
+};
+
+/**
+ * @brief Data asset for tuning weapon damage without touching code.
+ * 
+ * Weapon type and rarity combinations that are not in DamageOverrides keep the damage from WeaponDamage::DefaultMatrix.
+ */
+UCLASS(BlueprintType)
+class ULTIMATESHOOTER_API UWeaponDamageAsset : public UPrimaryDataAsset
+{
+	GENERATED_BODY()
+
+public:
+	/**
+	 * @brief Construct a new UWeaponDamageAsset object with no falloff
+	 * 
+	 */
+	UWeaponDamageAsset();
+
+	/**
+	 * @brief Gets the damage of the weapon type and rarity
+	 * 
+	 * @param Type Weapon type
+	 * @param Rarity Item rarity
+	 * @return FWeaponDamageValues Override from DamageOverrides, or the default damage if there is none
+	 */
+	FWeaponDamageValues GetDamage(EWeaponType Type, EItemRarity Rarity) const;
+
+	/**
+	 * @brief Gets the damage falloff settings as a damage model
+	 * 
+	 * @return FWeaponDamageModel Damage model evaluated for every bullet that hits
+	 */
+	FWeaponDamageModel GetDamageModel() const;
+
+private:
+	//! Damage for specific weapon type and rarity combinations
+	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "Damage", meta = (AllowPrivateAccess = "true"))
+	TArray<FWeaponDamageOverride> DamageOverrides;
+
+	//! Distance up to which bullets do full damage
+	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "Falloff", meta = (AllowPrivateAccess = "true"))
+	float FalloffStartDistance;
+
+	//! Distance at which bullets do MinFalloffMultiplier of their damage
+	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "Falloff", meta = (AllowPrivateAccess = "true"))
+	float FalloffEndDistance;
+
+	//! Damage multiplier at FalloffEndDistance and beyond
+	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "Falloff", meta = (AllowPrivateAccess = "true", ClampMin = "0.0", ClampMax = "1.0"))
+	float MinFalloffMultiplier;
+};
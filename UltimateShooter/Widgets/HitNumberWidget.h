@@ -0,0 +1,36 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Blueprint/UserWidget.h"
+#include "HitNumberWidget.generated.h"
+
+/**
+ * @brief Base class for the Hit Number widget Blueprint.
+ * 
+ * Hit Number widgets are created once by AShooterPlayerController and reused for every hit, so the Blueprint sets its
+ * text, color and animation in OnHitNumberShown instead of on construct.
+ */
+UCLASS()
+class ULTIMATESHOOTER_API UHitNumberWidget : public UUserWidget
+{
+	GENERATED_BODY()
+
+public:
+	/**
+	 * @brief Event implemented in the Blueprint, called every time the widget is taken from the pool for a new hit
+	 * 
+	 * @param Damage damage amount to show
+	 * @param HeadShot determines the color of the widget (true = yellow, false = white)
+	 */
+	UFUNCTION(BlueprintImplementableEvent)
+	void OnHitNumberShown(int32 Damage, bool HeadShot);
+
+	/**
+	 * @brief Event implemented in the Blueprint, called when the widget goes back to the pool
+	 * 
+	 */
+	UFUNCTION(BlueprintImplementableEvent)
+	void OnHitNumberHidden();
+};